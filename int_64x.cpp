@@ -1,165 +1,116 @@
 #include <Header_Files/pch.h>
 #include <Header_Files/print.h>
 #include <Header_Files/int_64x.h>
+#include <Header_Files/int_64x_fixed.h>
+#include <Header_Files/int_64x_parallel.h>
 #include <iostream>
 #include <bitset>
 #include <cmath>
 
-//Table for calculation of log2(x)
-const int tab64[64] = {
-	63,  0, 58,  1, 59, 47, 53,  2,
-	60, 39, 48, 27, 54, 33, 42,  3,
-	61, 51, 37, 40, 49, 18, 28, 20,
-	55, 30, 34, 11, 43, 14, 22,  4,
-	62, 57, 46, 52, 38, 26, 32, 41,
-	50, 36, 17, 19, 29, 10, 13, 21,
-	56, 45, 25, 31, 35, 16,  9, 12,
-	44, 24, 15,  8, 23,  7,  6,  5 };
-
-int_64x::int_64x(int number)
+int_64x::int_64x() : digits(int_64x_memory_resource())
+{
+}
+int_64x::int_64x(int number) : digits(int_64x_memory_resource())
 {
 	//it doesn't matter whether a positive or a negative integer is passed, either can be converted directly
 	//to an unsigned long long
 	digits.push_back(number);
 }
-int_64x::int_64x(unsigned int number)
+int_64x::int_64x(unsigned int number) : digits(int_64x_memory_resource())
 {
 	//an unsigned int needs to be a positive value, however it will only take up half of the space of an unsigned
 	//long, therefore we can just directly cast it
 	digits.push_back(number);
 }
-int_64x::int_64x(long long number)
+int_64x::int_64x(long long number) : digits(int_64x_memory_resource())
 {
 	//a standard long long can be positive or negative, we can just initialize the int_64x type as is
 	digits.push_back(number);
 }
-int_64x::int_64x(unsigned long long number, int left_shift)
+int_64x::int_64x(unsigned long long number, int left_shift) : digits(int_64x_memory_resource())
 {
 	//an unsigned long long can only be positive, therefore if the lead bit is a 1 then we need to add
 	//a word of all 0's to the front of the int_64x type so that it retains its positivity.
-	digits.push_back(number);
-	if (number >> 63) digits.push_back(0);
 
 	//This constructor can also be useful during the multiplication process. If a value is given to left shift
-	//then the int_64x type will be left shifted by that amount upon creation. Caution should be used when 
-	//initializing via left shift on a negative number. This is allowable, however, it will be casted to a positive
+	//then the int_64x type will be left shifted by that amount upon creation. The words are written straight into
+	//their final spots instead of calling <<= so int_64x(1, k) is a quick way to create 2^k. Caution should be used
+	//when initializing via left shift on a negative number. This is allowable, however, it will be casted to a positive
 	//value (left shifting an already initialized negative number works just fine).
-	*this <<= left_shift;
+	if (left_shift < 0 || number == 0) left_shift = 0;
+	int word_shift = left_shift / 64, bit_shift = left_shift % 64;
+	unsigned long long high = bit_shift ? (number >> (64 - bit_shift)) : 0;
+
+	digits.reserve(word_shift + 3);
+	digits.assign(word_shift, 0);
+	digits.push_back(number << bit_shift);
+	if (high) digits.push_back(high);
+	if (digits.back() >> 63) digits.push_back(0);
 }
-int_64x::int_64x(std::string number)
+int_64x::int_64x(std::string number) : digits(int_64x_memory_resource())
 {
 	//This is the main way to initialize an int_64x type. A string of numbers, positive or negative can be passed
 	//and then converted. The only acceptable characters are the digits 0-9 and the '-' symbol, which will only
 	//be accepted as the very first character in the string otherwise it's not allowed.
 
-	//First store digits of number in an array. Then create a different array which will hold powers of two.
-	//Keep multiplying the two array by two until it's larger than the number held in the other array. From here,
-	//keep dividing the power of two array by 2 until it's smaller than the number array and then subtract the two array from
-	//the number array. The BigInt_128 will need to be built bit-by-bit in this fashion. For now this is the quickest way
-	//I can think of to construct a binary representation of a number from a string of characters.
-
-	//funky things happen if a string of "1" is passed to this function, best to just check for this case and manually set
-	//TODO: there's probably a much better way to implement this check, come back to this at some point
-	if (number == "1")
-	{
-		digits.push_back(1);
-		return;
-	}
-	else if (number == "-1")
-	{
-		digits.push_back(-1);
-		return;
-	}
-
+	//The digits are read in chunks of up to 19 at a time (the most that are guaranteed to fit into a single unsigned long long).
+	//Everything read so far gets multiplied by 10^(chunk length) and then the chunk is added in, so the number is built up a full
+	//word at a time instead of bit by bit. The magnitude is built first and then flipped at the end for negative numbers.
 	bool negative = false; //if the first character of number is the '-' symbol this will be set to true so we know to flip the bits later on
-	int end_point = 0; //this marks where we stop reading the string "number"
+	int start_point = 0; //this marks where we start reading the string "number"
 	if (number[0] == '-')
 	{
 		negative = true;
-		end_point = 1; //don't want to try and incorporate the '-' sign into our actual number
+		start_point = 1; //don't want to try and incorporate the '-' sign into our actual number
 	}
 
-	//all arrays in this algorithm are backwards, i.e. given a string of "12345" an array of [5, 4, 3, 2, 1] will be created
-	int* base_ten = new int[number.length() + 1]();
-	int* two_power = new int[number.length() + 1](); //at most two_power will need to be one digit longer than base_ten
-	two_power[0] = 1; //start with 2^0 = 1
+	digits.reserve(number.length() / 19 + 2); //each word holds a little more than 19 decimal digits
+	digits.push_back(0);
 
-	int power = 0; //using a signed int means the largest number we can make is 2^(2^(31 - 1)) = 2^2,147,483,647 = 10^~646,456,993 (aka a long effing number)
-	for (int i = number.length(); i > end_point; i--)
+	unsigned long long chunk = 0, chunk_power = 1;
+	int chunk_length = 0;
+	for (int i = start_point; i <= number.length(); i++)
 	{
-		if ((number[i - 1] > 57) || (number[i - 1] < 48))
+		if (i < number.length())
 		{
-			//need to make sure that we're only reading digits, otherwise we might get some garbage in the input string
-			//TODO: add in some way to skip characters encountered that aren't actual digits. This would cause shifting everything already
-			//      in the array and I don't want to do it right now.
-			std::cout << "Found something in the number that's not a real digit, skipping it." << std::endl;
-			continue;
-		}
-		base_ten[number.length() - i] = number[i - 1] - 48; //remove 48 to get from character representation of digit to actual number
-	}
-
-	//multiply two_power by 2 until it is larger than the number now stored in base_ten
-	while (!CompareArraySize(two_power, base_ten, number.length() + 1))
-	{
-		MultiplyArrayByTwo(two_power, number.length() + 1);
-		power++;
-	}
-
-	//as soon as two_power becomes larger than base_ten divide it by two and reduce the power count by 1
-	DivideArrayByTwo(two_power, number.length() + 1);
-	power--;
-
-	//Next we need to see how many unsigned long long integers will be necessary to hold the entire number, this is fairly easy to
-	//do by looking at the value of power. If power equals 200 for example then we need cieling(200 / 64) = 4 unsigned long longs
-	//to hold all of the binary digits.
-	int number_of_longs = power / 64 + 1;
-
-	for (int i = 0; i < number_of_longs; i++) digits.push_back(0);
-
-	//now subtract two_power from base_ten and set the appropriate bit in digits
-	unsigned long long num = 0, placement; //num keeps track of the actual number while placement tells us where to place the next binary digit
-	while (power > 0)
-	{
-		placement = (unsigned long long)1 << (power % 64);
-		//go to the next 64-bit unsigned long long whenever power = 0 modulo 63
-		while (power % 64 != 0)
-		{
-			if (!CompareArraySize(two_power, base_ten, number.length() + 1)) //two_power is smaller than base_ten
+			if ((number[i] > 57) || (number[i] < 48))
 			{
-				SubtractArrays(base_ten, two_power, number.length() + 1); //subtract two_power from base_ten
-				num |= placement;
+				//need to make sure that we're only reading digits, otherwise we might get some garbage in the input string
+				std::cout << "Found something in the number that's not a real digit, skipping it." << std::endl;
+				continue;
 			}
-			DivideArrayByTwo(two_power, number.length() + 1);
-			placement >>= 1;
-			power--;
+			chunk = 10 * chunk + (number[i] - 48); //remove 48 to get from character representation of digit to actual number
+			chunk_power *= 10;
+			chunk_length++;
 		}
 
-		//once pow = 0 % 64 we've hit the final binary digit of the current 64-bit unsigned long long so we need to move to the next one
-		//need to do one final check. TODO - consider putting this check into a separate function to avoid writing it out twice
-		if (!CompareArraySize(two_power, base_ten, number.length() + 1)) //two_power is smaller than base_ten
+		//add the chunk in whenever it's full and once more at the very end of the string
+		if (chunk_length == 19 || (i == number.length() && chunk_length))
 		{
-			SubtractArrays(base_ten, two_power, number.length() + 1); //subtract two_power from base_ten
-			num |= placement;
+			unsigned long long carry = MultiplyWordsBySingle(digits.data(), digits.data(), digits.size(), chunk_power);
+			if (carry) digits.push_back(carry);
+			digits.push_back(0);
+			AddWordAt(digits.data(), digits.size(), 0, chunk);
+			if (digits.back() == 0) digits.pop_back();
+
+			chunk = 0;
+			chunk_power = 1;
+			chunk_length = 0;
 		}
-		DivideArrayByTwo(two_power, number.length() + 1);
-		digits[number_of_longs - 1] = num;
-		number_of_longs--; //TODO: I think i can convert the above line to *digits[--number_of_longs] = num and have the same effect
-		num = 0;
-		power--;
 	}
 
-	//We've succesfully turned the string into a binary representation, make sure to free up the memory that we no longer need
-	delete[] base_ten;
-	delete[] two_power;
-
 	//We need to make sure that any positive numbers don't have their lead bit as a 1, if so then add a 0 as the lead word of the number
 	if (this->digits.back() >> 63) this->digits.push_back(0);
 
 	//once we've set all the bits, we need to flip them and then add 1 (two's complement) if the number was defined as a negative,
 	//otherwise we're done
-	if (negative) twosComplement(*this);
+	if (negative)
+	{
+		NegateWords(digits.data(), digits.size());
+		RemoveRedundantWords(digits);
+	}
 }
-int_64x::int_64x(const int_64x& num)
+int_64x::int_64x(const int_64x& num) : digits(int_64x_memory_resource())
 {
 	//std::cout << "Copy constructor called." << std::endl;
 	//copy constructor for class, utilizes the overloaded = operator
@@ -170,105 +121,48 @@ int_64x::int_64x(const int_64x& num)
 //Addition Operators
 int_64x& int_64x::operator+=(const int_64x& num)
 {
-	//C++ can handle addition of unsigned long longs without any problem so we add each word from *this to the same word in num and then manually
-	//keep track of whether or not each of these additions results in an overflow. Once all of these partial additions has been complete, we need
-	//to determine whether or not the final sum remains the same, has it's most significant word removed or has another word added to the front.
-
-	//The first thing we need to do is compare the polarities of the two numbers, this will let us know if the sum should be larger or smaller than
-	//the original number
-	unsigned long long different_polarity = this->digits.back() ^ num.digits.back();
-	int diff = num.digits.size() - this->digits.size(), carry = 0; //carry keeps track of overflow between addition of individual 64-bit words
-
-	//if num has more words than *this we need to add empty words so that the lenghts are the same. The below loop will only execute if num
-	//has more words than *this
-	for (int i = 0; i < diff; i++) this->digits.push_back(0);
-
-	unsigned long long this_temp, num_temp; //temporary variables are created on stack to reduce calls to heap memory
-	//add all of the 64-bit words from num to the 64-bit words from *this
-	for (int i = 0; i < num.digits.size(); i++)
+#if defined(INT_64X_NATIVE_128)
+	//if both numbers fit into 128 bits and so does the answer then there's no need to go word by word
+	__int128 this_value, num_value, answer;
+	if (LoadNative(this->digits, this_value) && LoadNative(num.digits, num_value) && !__builtin_add_overflow(this_value, num_value, &answer))
 	{
-		this_temp = this->digits[i];
-		num_temp = num.digits[i];
-		//first add the carry bit if it's non-zero
-		if (carry)
-		{
-			//*(this->digits[i]) += carry;
-			this_temp += carry;
-
-			//it's unlikely, but possible that adding the carry bit will overflow the current word, in which case digits[i] will equal 0. If
-			//digits[i] == 0 then carry remains at 1, otherwise carry is set to 0.
-			//carry = (!(*(this->digits[i])));
-			carry = (!this_temp);
-		}
-
-		//Then add the two numbers together. If *this.digits[i] ends up being less than num.digits[i] after the addition we know that overflow has occurred.
-		/**(this->digits[i]) += *num.digits[i];
-		if (*(this->digits[i]) < *num.digits[i]) carry = 1;*/
-		this_temp += num_temp;
-		if (this_temp < num_temp) carry = 1;
-		this->digits[i] = this_temp;
+		StoreNative(this->digits, answer);
+		return *this;
 	}
+#endif
 
-	//in the case that *this has more words than num we need another loop to handle any more potential carry over. This loop will only
-	//commence if *this has more words than num. If num is negative we also need to add 0xFFFFFFFFFFFFFFFF during each iteration
-	if (num.digits.back() & 0x8000000000000000)
-	{
-		for (int i = 0; i < (this->digits.size() - num.digits.size()); i++)
-		{
-			//Need to add the implied 0xFFFFFFFFFFFFFFFF at the front of the smaller negative number
-			this_temp = this->digits[num.digits.size() + i];
-			this_temp += carry;
-			carry = carry && (!this_temp);
-			this_temp += 0xFFFFFFFFFFFFFFFF;
-			if (this_temp < 0xFFFFFFFFFFFFFFFF) carry = 1;
-			this->digits[num.digits.size() + i] = this_temp;
-		}
-	}
-	else
+	//numbers up to FIXED_KERNEL_WORDS long are added with the unrolled kernel for their sizes into a sum on the stack
+	int this_size = this->digits.size(), num_size = num.digits.size();
+	if (UseFixedKernels(this_size, num_size))
 	{
-		//No need to add anything extra here as we're adding to words that are 0x0000000000000000, we can break as soon as there's no carry
-		if (carry)
-		{
-			for (int i = 0; i < (this->digits.size() - num.digits.size()); i++)
-			{
-				this->digits[num.digits.size() + i] += carry;
-				carry = carry && (!(this->digits[num.digits.size() + i]));
-				if (!carry) break;
-			}
-		}
+		unsigned long long sum[FIXED_KERNEL_WORDS + 1];
+		fixed_addition_kernels[FixedKernelIndex(this_size, num_size)](sum, this->digits.data(), num.digits.data());
+		StoreWords(this->digits, sum, (this_size > num_size ? this_size : num_size) + 1);
+		return *this;
 	}
 
-	//The addition is done at this point, however, we need to either add a new word for numbers that have reversed polarity that shouldn't have,
-	//or remove a word from the front of the number that have become redundant (or just leave the answer as is)
-	if (different_polarity >> 63)
-	{
-		//the original numbers had different polarities, we need to either remove a word(s) or keep the answer the same. We only need to remove a
-		//redundant word if the most significant word is 0 or 0xFFFFFFFFFFFFFFFF.
+	//C++ can handle addition of unsigned long longs without any problem so we add each word from num to the same word in *this and
+	//keep track of the carry between words with AddWords(). Both numbers are treated as if they were sign extended to one word longer
+	//than the longest of them, the sum of two numbers can never need more than one extra word so there's no need to figure out ahead
+	//of time if the answer is going to grow or shrink. Any words past the end of num are its sign (0 or 0xFFFFFFFFFFFFFFFF).
+	unsigned long long this_sign = 0 - (this->digits.back() >> 63), num_sign = 0 - (num.digits.back() >> 63);
+	int size = (this_size > num_size ? this_size : num_size) + 1;
+	this->digits.resize(size, this_sign); //num.digits is read after this in case num and *this are the same number
 
-		//we need to remove the most significant word under two conditions. First, the length of *this is greater than 1
-		//and second, the polarity of the most significant word matches that of the second most significant word
-		int start = this->digits.size() - 1;
-		for (int i = start; i >= 1; i--)
-		{
-			//this for loop will only execute if the length of *this is greater than 1 word and will terminate before elimating the first word
-			if ((this->digits[i] == 0) || (this->digits[i] == 0xFFFFFFFFFFFFFFFF))
-			{
-				if (!((this->digits[i] ^ this->digits[i - 1]) >> 63))
-				{
-					//polarities of final two words are the same so remove the final word
-					this->digits.erase(this->digits.end() - 1);
-				}
-				else break;
-			}
-		}
-		return *this;
-	}
-	else
+	unsigned long long* words = this->digits.data();
+	unsigned long long carry = AddWords(words, num.digits.data(), num_size), sum;
+	for (int i = num_size; i < size; i++)
 	{
-		//the original numbers had the same polarity, we need to either add a new word or keep the answer the same
-		if ((this->digits.back() ^ num.digits.back()) >> 63) this->digits.push_back(0 - (num.digits.back() >> 63));
-		return *this;
+		sum = words[i] + carry;
+		carry = (sum < carry);
+		sum += num_sign;
+		carry += (sum < num_sign);
+		words[i] = sum;
 	}
+
+	//the extra word is only kept if it's needed to hold the sign, anything else that's become redundant is removed unless
+	//lazy normalization is active
+	TrimWords(this->digits);
 	return *this;
 }
 int_64x operator+(const int_64x& num1, const int_64x& num2)
@@ -283,108 +177,42 @@ int_64x operator+(const int_64x& num1, const int_64x& num2)
 //Subtraction Operators
 int_64x& int_64x::operator-=(const int_64x& num)
 {
-	//Subtraction can be approached in the exact same way as addition, however, just in the opposite manner. Starting from the LSB and
-	//moving towards the MSB subtract the current word in num from the current word of *this. If the value is greater than the original
-	//value of this then an overflow has occured. Instead of adding 1 to the next word like in addition, we remove 1 from the next word
-	//and so on and so forth. Subtraction is inherently slower than addition, but since built in functions are being used they should be
-	//on par with each other.
-
-	//The first thing we need to do is compare the polarities of the two numbers, this will let us know if the sum should be larger or smaller than
-	//the original number
-	unsigned long long different_polarity = this->digits.back() ^ num.digits.back();
-	int diff = num.digits.size() - this->digits.size(), carry = 0; //carry keeps track of overflow between addition of individual 64-bit words
-
-	//if num has more words than *this we need to add empty words so that the lenghts are the same. The below loop will only execute if num
-	//has more words than *this. Make sure to push back the appropriate word (0 for positive and -1 for negative).
-	for (int i = 0; i < diff; i++) this->digits.push_back(0 - (this->digits.back() >> 63));
-
-	unsigned long long this_temp, num_temp; //create a temporary variable on stack to reduce calls to heap memory
-	//subtract all of the 64-bit words in num from the 64-bit words in *this
-	for (int i = 0; i < num.digits.size(); i++)
-	{
-		this_temp = this->digits[i];
-		num_temp = num.digits[i];
-		//first remove the carry bit if it's non-zero
-		if (carry)
-		{
-			//it's unlikely, but possible that removing the carry bit will overflow the current word, in which case digits[i] will equal 0xFFFFFFFFFFFFFFFF.
-			//If digits[i] == 0xFFFFFFFFFFFFFFFF then carry remains at 1, otherwise carry is set to 0. Carry must be set before the subtraction for easier
-			//formula.
-			carry = (!(this_temp));
-			this_temp -= 1;
-		}
-
-		//Then subtract the two numbers. If *this.digits[i] ends up increasing after the subtraction we know that overflow has occurred.
-		this_temp -= num_temp;
-		if (this_temp > this->digits[i]) carry = 1;
-		this->digits[i] = this_temp;
-	}
-
-	//In the case that *this has more words than num we need another loop to handle any more potential carry over. This loop will only
-	//commence if *this has more words than num. If num is negative we also need to add 0xFFFFFFFFFFFFFFFF during each iteration
-	if (num.digits.back() & 0x8000000000000000)
+#if defined(INT_64X_NATIVE_128)
+	//if both numbers fit into 128 bits and so does the answer then there's no need to go word by word
+	__int128 this_value, num_value, answer;
+	if (LoadNative(this->digits, this_value) && LoadNative(num.digits, num_value) && !__builtin_sub_overflow(this_value, num_value, &answer))
 	{
-		for (int i = 0; i < (this->digits.size() - num.digits.size()); i++)
-		{
-			//Need to add the implied 0xFFFFFFFFFFFFFFFF at the front of the smaller negative number
-			this_temp = this->digits[num.digits.size() + i];
-			if (carry)
-			{
-				//it's unlikely, but possible that removing the carry bit will overflow the current word, in which case digits[i] will equal 0xFFFFFFFFFFFFFFFF.
-				//If digits[i] == 0xFFFFFFFFFFFFFFFF then carry remains at 1, otherwise carry is set to 0. Carry must be set before the subtraction.
-				carry = (!(this_temp));
-				this_temp -= 1;
-			}
-			this_temp -= 0xFFFFFFFFFFFFFFFF; //TODO: Might be able to change this to + 1 for a little speedup
-			if (this_temp > this->digits[num.digits.size() + i]) carry = 1;
-			this->digits[num.digits.size() + i] = this_temp;
-		}
-	}
-	else
-	{
-		//No need for extra subtractions as we'd be subtracting 0x0000000000000000, we can break as soon as there's no carry
-		if (carry)
-		{
-			for (int i = 0; i < (this->digits.size() - num.digits.size()); i++)
-			{
-				carry = (!(this->digits[num.digits.size() + i]));
-				this->digits[num.digits.size() + i] -= 1;
-				if (!carry) break;
-			}
-		}
+		StoreNative(this->digits, answer);
+		return *this;
 	}
+#endif
 
-	//The subtraction is done at this point, however, we need to either add a new word for numbers that have reversed polarity that shouldn't have,
-	//or remove words from the front of the number that have become redundant (or just leave the answer as is)
-	if (different_polarity >> 63)
+	int this_size = this->digits.size(), num_size = num.digits.size();
+	if (UseFixedKernels(this_size, num_size))
 	{
-		//the original numbers had different polarities, we need to either add a new word or keep the answer the same
-		if (!((this->digits.back() ^ num.digits.back()) >> 63)) this->digits.push_back(0 - !(num.digits.back() >> 63));
+		unsigned long long difference[FIXED_KERNEL_WORDS + 1];
+		fixed_subtraction_kernels[FixedKernelIndex(this_size, num_size)](difference, this->digits.data(), num.digits.data());
+		StoreWords(this->digits, difference, (this_size > num_size ? this_size : num_size) + 1);
 		return *this;
 	}
-	else
-	{
-		//the original numbers had the same polarity, we need to either remove a word or keep the answer the same. We only need to remove a
-		//redundant word if the most significant word is 0 or 0xFFFFFFFFFFFFFFFF.
 
-		//we need to remove the most significant word under two conditions. First, the length of *this is greater than 1
-		//and second, the polarity of the most significant word matches that of the second most significant word
-		int start = this->digits.size() - 1;
-		for (int i = start; i >= 1; i--)
-		{
-			//this for loop will only execute if the length of *this is greater than 1 word and will terminate before elimating the first word
-			if ((this->digits[i] == 0) || (this->digits[i] == 0xFFFFFFFFFFFFFFFF))
-			{
-				if (!((this->digits[i] ^ this->digits[i - 1]) >> 63))
-				{
-					//polarities of final two words are the same so remove the final word
-					this->digits.erase(this->digits.end() - 1);
-				}
-				else break;
-			}
-		}
-		return *this;
+	//Subtraction is approached in the exact same way as addition, just with SubtractWords() and a borrow instead of a carry.
+	unsigned long long this_sign = 0 - (this->digits.back() >> 63), num_sign = 0 - (num.digits.back() >> 63);
+	int size = (this_size > num_size ? this_size : num_size) + 1;
+	this->digits.resize(size, this_sign);
+
+	unsigned long long* words = this->digits.data();
+	unsigned long long borrow = SubtractWords(words, num.digits.data(), num_size), difference, next_borrow;
+	for (int i = num_size; i < size; i++)
+	{
+		difference = words[i] - num_sign;
+		next_borrow = (difference > words[i]);
+		next_borrow += (difference < borrow);
+		words[i] = difference - borrow;
+		borrow = next_borrow;
 	}
+
+	TrimWords(this->digits);
 	return *this;
 }
 int_64x operator-(const int_64x& num1, const int_64x& num2)
@@ -399,100 +227,57 @@ int_64x operator-(const int_64x& num1, const int_64x& num2)
 //Multiplication Operators
 int_64x& int_64x::operator*=(const int_64x& num)
 {
-	//The goal here is to multiply two int_64x types using the Karatsuba multiplication method. The number of multiplications that
-	//needs to be carried out is the number of 64-bit words in *this x 64-bit words in num (so when multiplying two numbers that each
-	//have two 64-bit words, a total of 4 Karatsuba multiplications will take place).
-
-	//If the numbers being multiplied are small enough we can do all the arithmetic with memory located on the stack instead of the heap
-	//which ends up being ~30% quicker.
-	if ((this->digits.size() <= 50) && (num.digits.size() <= 50))
+	//multiplication is carried out by multiply() using the scratch buffers of the current thread
+	return this->multiply(num, int_64x_workspace::local());
+}
+int_64x& int_64x::multiply(const int_64x& num, int_64x_workspace& workspace)
+{
+	//The magnitudes of *this and num are copied into the workspace (flipping them if they're negative) and then multiplied one
+	//row at a time with MultiplyAddWords(), where each row is the whole of *this multiplied by a single word of num. Every partial
+	//product is a full 128-bit multiplication so there's no need to split words into 32-bit halves and keep track of the sign of
+	//the middle term. Since the workspace keeps its buffers between calls nothing is allocated here once the workspace has grown
+	//big enough, and digits only allocates if the product is longer than anything *this has held before.
+	if (this->digits.empty() || num.digits.empty())
 	{
-		FastMultiplication(num);
+		this->zero();
 		return *this;
 	}
 
-	unsigned long long z2, z0, a, b, c, d; //these variables hold the value of the partial multiplications at each iteration
-	long long z1; //z1 has the potential to become negative so make it a signed long long
-
-	//first we need to see if *this or num are negative, if so, flip them and keep track of it
-	bool negative[2] = { false, false };
-	unsigned long long* num_copy = new unsigned long long[num.digits.size()](); //create a copy of num in case it's polarity needs to be reversed
-	for (int i = 0; i < num.digits.size(); i++) num_copy[i] = num.digits[i];
-	if (this->digits.back() >> 63)
-	{
-		twosComplement(*this); //flip the negative number to positive
-		negative[0] = true;
-	}
-	if (num.digits.back() >> 63)
+#if defined(INT_64X_NATIVE_128)
+	//numbers with a product that fits into 128 bits don't need the workspace at all
+	__int128 this_value, num_value, answer;
+	if (LoadNative(this->digits, this_value) && LoadNative(num.digits, num_value) && !__builtin_mul_overflow(this_value, num_value, &answer))
 	{
-		int k = num.digits.size() - 1;
-		for (; k >= 0; k--) num_copy[k] = ~num_copy[k];
-		k++; //set k back to 0 after loop
-		while (num_copy[k] == 0xFFFFFFFFFFFFFFFF)
-		{
-			num_copy[k] = 0;
-			k++;
-		}
-
-		num_copy[k] += 1;
-		negative[1] = true;
-	}
-
-	//we need to resize *this so that the multiplication will fit into it, the new size will be equal to the number of 64-bit words in
-	//*this added to the number of 64-bit words in num
-	int start = this->digits.size() - 1;
-	for (int i = 0; i < num.digits.size(); i++) this->digits.push_back(0);
-
-	//were eventually going to be overwriting the existing words in *this with our partial multiplications, so we need to work backwards from the
-	//end of *this and multiply all 32-bit sub numbers with all 32-bit sub numbers of num. The last multiplication from a word in *this will end up
-	//overwriting itself which is ok
-
-	for (int i = start; i >= 0; i--)
-	{
-		for (int j = num.digits.size() - 1; j >= 0; j--)
-		{
-			//inside this n loop is where each Karatsuba multiplication takes place. each multiplication that takes place inside
-			//the loop will have the same index so no shifting needs to take place until this loop terminates.
-			a = this->digits[i] >> 32;
-			b = this->digits[i] & 0x00000000FFFFFFFF;
-			c = num_copy[j] >> 32;
-			d = num_copy[j] & 0x00000000FFFFFFFF;
-
-			z2 = a * c;
-			z0 = b * d;
-			z1 = (b - a) * (c - d) + z2 + z0; //z1 is a signed variable so there should be no issue dealing with negative numbers
-
-			//since we're only dealing with positive numbers then every partial multiplication should be positive so we should do unsigned additions.
-			//TODO: It may actually be possible for z1 to be negative, if things start acting funny see if this is happening and add a signed addition for it
-
-			//when adding z2 and z0 to their respective totals an unsigned addition takes place because there are only positive numbers.
-			//z1 will be added normally as it may be positive or negative
-			this->partialAddition(z2, i + j + 1);
-			this->partialAddition(z1 >> 32, i + j + 1);
-
-			//If *this is going to overwrite itself then set the word equal to z1 << 32 instead of add z1 << 32
-			if (j == 0) this->digits[i] = z1 << 32;
-			else this->partialAddition(z1 << 32, i + j);
-
-			this->partialAddition(z0, i + j);
-		}
+		StoreNative(this->digits, answer);
+		return *this;
 	}
+#endif
 
-	//if *this or num was negative, but not both, then *this needs to be inverted
-	if (negative[0] ^ negative[1]) twosComplement(*this);
-
-	//add a loop here about removing leading zeros and then multiplication is done. Since we're only multiplying positive numbers just need to look for 0
-	for (int i = this->digits.size() - 1; i > 0; i--)
+	//numbers up to FIXED_KERNEL_WORDS long are multiplied by the unrolled kernel for their sizes, which works on the two's
+	//complement words directly so nothing needs to be flipped to positive first
+	int this_size = this->digits.size(), num_size = num.digits.size();
+	if (UseFixedKernels(this_size, num_size))
 	{
-		if ((this->digits[i] == 0) || (this->digits[i] == -1))
-		{
-			if ((this->digits[i - 1] >> 63) ^ (this->digits[i] >> 63)) break;
-			this->digits.erase(this->digits.end() - 1);
-		}
-		else break;
+		unsigned long long product[2 * FIXED_KERNEL_WORDS];
+		fixed_multiplication_kernels[FixedKernelIndex(this_size, num_size)](product, this->digits.data(), num.digits.data());
+		StoreWords(this->digits, product, this_size + num_size);
+		return *this;
 	}
 
-	delete[] num_copy;
+	bool negative = (this->digits.back() ^ num.digits.back()) >> 63;
+	unsigned long long* this_words = workspace.buffer(int_64x_workspace::OPERAND_ONE, this_size);
+	unsigned long long* num_words = workspace.buffer(int_64x_workspace::OPERAND_TWO, num_size);
+	this_size = CopyMagnitude(this->digits, this_words);
+	num_size = CopyMagnitude(num.digits, num_words);
+
+	//squaring a number only needs a little more than half of the partial products. Very long products get split up over the
+	//shared thread pool when an int_64x_parallel_scope is active on this thread.
+	unsigned long long* product = workspace.buffer(int_64x_workspace::RESULT, this_size + num_size);
+	const int_64x_parallel_settings* parallel = int_64x_parallel_scope::active();
+	if (UseParallelMultiplication(this_size, num_size, parallel)) ParallelMultiplyMagnitudes(product, this_words, this_size, num_words, num_size, *parallel);
+	else if (&num == this) SquareWords(product, this_words, this_size);
+	else MultiplyMagnitudes(product, this_words, this_size, num_words, num_size);
+	StoreMagnitude(this->digits, product, this_size + num_size, negative);
 	return *this;
 }
 int_64x operator*(const int_64x& num1, const int_64x& num2)
@@ -505,354 +290,368 @@ int_64x operator*(const int_64x& num1, const int_64x& num2)
 }
 void int_64x::FastMultiplication(const int_64x& num)
 {
-	//this function is called when multiplying two numbers that are relatively small. Copies of both num and *this are
-	//created on the stack so that accessing memory will be quicker. If both num and *this are 50 words long or less then
-	//this function will be used for multiplication. This function needs 1.6kB of stack memory to operate, however, the
-	//memory is freed up as soon as the multiplication is complete so this function can be called any number of times in
-	//the same application.
-
-	unsigned long long z2, z0, a, b, c, d; //these variables hold the value of the partial multiplications at each iteration
-	long long z1; //z1 has the potential to become negative so make it a signed long long
-
-	//first we create copies of *this and num on the stack in fixed arrays of 50 elements and we create a container for their
-	//multiplication which is 100 elements
-	unsigned long long this_copy[50] = { 0 }, num_copy[50] = { 0 }, ans[100] = { 0 };
-	for (int i = 0; i < this->digits.size(); i++) this_copy[i] = this->digits[i];
-	for (int i = 0; i < num.digits.size(); i++) num_copy[i] = num.digits[i];
-
-	//if *this or num are negative flip them and keep track of it
-	bool negative[2] = { false, false };
-
-	if (this->digits.back() >> 63)
-	{
-		int k = this->digits.size() - 1;
-		for (; k >= 0; k--) this_copy[k] = ~this_copy[k];
-		k++; //set k back to 0 after loop
-		while (this_copy[k] == 0xFFFFFFFFFFFFFFFF)
-		{
-			this_copy[k] = 0;
-			k++;
-		}
-
-		this_copy[k] += 1;
-		negative[0] = true;
-	}
-	if (num.digits.back() >> 63)
-	{
-		int k = num.digits.size() - 1;
-		for (; k >= 0; k--) num_copy[k] = ~num_copy[k];
-		k++; //set k back to 0 after loop
-		while (num_copy[k] == 0xFFFFFFFFFFFFFFFF)
-		{
-			num_copy[k] = 0;
-			k++;
-		}
-
-		num_copy[k] += 1;
-		negative[1] = true;
-	}
-
-	//we need to resize *this so that the multiplication will fit into it, the new size will be equal to the number of 64-bit words in
-	//*this added to the number of 64-bit words in num
-	int start = this->digits.size() - 1;
-	for (int i = start; i >= 0; i--)
-	{
-		for (int j = num.digits.size() - 1; j >= 0; j--)
-		{
-			//inside this n loop is where each Karatsuba multiplication takes place. each multiplication that takes place inside
-			//the loop will have the same index so no shifting needs to take place until this loop terminates.
-			a = this_copy[i] >> 32;
-			b = this_copy[i] & 0x00000000FFFFFFFF;
-			c = num_copy[j] >> 32;
-			d = num_copy[j] & 0x00000000FFFFFFFF;
-
-			z2 = a * c;
-			z0 = b * d;
-			z1 = (b - a) * (c - d) + z2 + z0; //z1 is a signed variable so there should be no issue dealing with negative numbers
-
-			//since we're only dealing with positive numbers then every partial multiplication should be positive so we should do unsigned additions.
-			//TODO: It may actually be possible for z1 to be negative, if things start acting funny see if this is happening and add a signed addition for it
-
-			//when adding z2 and z0 to their respective totals an unsigned addition takes place because there are only positive numbers.
-			//z1 will be added normally as it may be positive or negative
-			unsignedAddition(ans, z2, 100, i + j + 1);
-
-			unsignedAddition(ans, z1 >> 32, 100, i + j + 1);
-			unsignedAddition(ans, z1 << 32, 100, i + j);
-
-			unsignedAddition(ans, z0, 100, i + j);
-		}
-	}
-
-	//if *this or num was negative, but not both, then ans needs to be inverted to a negative number
-	if (negative[0] ^ negative[1])
-	{
-		int k = num.digits.size() + this->digits.size() - 2; //although ans is 100 elements long, this is the amount that we've actually changed
-		for (; k >= 0; k--) ans[k] = ~ans[k];
-		k++; //set k back to 0 after loop
-		while (ans[k] == 0xFFFFFFFFFFFFFFFF)
-		{
-			ans[k] = 0;
-			k++;
-		}
-
-		ans[k] += 1;
-		negative[1] = true;
-	}
-
-	//now we copy over all of the useful digits from num and put them into *this, num is bigger than *this so digits will need to be added to *this
-	for (int i = 0; i < this->digits.size(); i++) this->digits[i] = ans[i];
-	int stop = this->digits.size() + num.digits.size();
-	for (int i = this->digits.size(); i < stop; i++) this->digits.push_back(ans[i]);
-
-	//with the multiplication complete, do a final check to make sure there are no unnecessary leading words
-	for (int i = this->digits.size() - 1; i > 0; i--)
-	{
-		if ((this->digits[i] == 0) || (this->digits[i] == -1))
-		{
-			if ((this->digits[i - 1] >> 63) ^ (this->digits[i] >> 63)) break;
-			this->digits.erase(this->digits.end() - 1);
-		}
-		else break;
-	}
+	//this function used to multiply numbers of 50 words or less using fixed arrays on the stack so that the heap wouldn't need to be
+	//used. The workspace buffers used by multiply() do the same job for numbers of any length, so this just forwards to it.
+	this->multiply(num, int_64x_workspace::local());
 }
 
 //Division Operators
 int_64x& int_64x::operator/=(const int_64x& num)
 {
-	//The concept of division here is that we wan't to left shift "num" as much as possible and have
-	//it be less than *this. After doing that subtract the left shifted "num" value from *this. Repeat
-	//this sequence until left shifting is no longer possible. Since each left shift represents a
-	//multiplication by 2, 12 total left shifts would mean multiplication by 2^12 = 4096
-
-	//Like we did with multiplication, if either number is negative just flip it to be positive and
-	//then convert the answer back to a negative number at the end of the function. This isn't the 
-	//most efficient way but it should be good enough for now.
+	//division is carried out by divide() using the scratch buffers of the current thread
+	return this->divide(num, int_64x_workspace::local());
+}
+int_64x& int_64x::divide(const int_64x& num, int_64x_workspace& workspace)
+{
+	//Like we did with multiplication, the magnitudes of both numbers are copied into the workspace and divided with the word by word
+	//long division in DivideWords(). Finally the quotient is flipped back to a negative number if only one of the inputs was negative,
+	//so just like the built in types the answer is rounded towards 0.
+	divideMagnitudes(num, workspace, true);
+	return *this;
+}
+int_64x operator/(const int_64x& num1, const int_64x& num2)
+{
+	//define division using the already defined /= operator, create a copy of num1 inside this function instead of
+	//passing a copy to the function, this reduces the amount of total copies created by 1
+	int_64x num1_copy = num1;
+	num1_copy /= num2;
+	return num1_copy;
+}
+int_64x& int_64x::operator%=(const int_64x& num)
+{
+	//modular division is carried out by modulo() using the scratch buffers of the current thread
+	return this->modulo(num, int_64x_workspace::local());
+}
+int_64x& int_64x::modulo(const int_64x& num, int_64x_workspace& workspace)
+{
+	//The long division gives us the remainder directly so there's no need to multiply the quotient back out and subtract it like we
+	//used to. The remainder keeps the sign of *this, which is the same answer as *this - num * (*this / num).
+	divideMagnitudes(num, workspace, false);
+	return *this;
+}
+void int_64x::divideMagnitudes(const int_64x& num, int_64x_workspace& workspace, bool keep_quotient)
+{
+	//shared code for divide() and modulo(). *this gets replaced by the quotient when keep_quotient is true and by the remainder
+	//otherwise
 
 	//Like with division of other built in types, we can't divide by zero here so the first thing we
-	//have to make sure of is that num doesn't equal 0. If so then an error is thrown.
-
-	//in order to keep num as a const value a copy of it is made and operated on.
-	int_64x num_copy = num;
-
-	//check to see if either number is negative, if so flip it to a positive number
-	bool flipped[2] = { false, false };
-	if (this->digits.back() & 0x8000000000000000)
-	{
-		twosComplement(*this); //make a flipped copy of *this
-		flipped[0] = true;
-	}
-	if (num_copy.digits.back() & 0x8000000000000000)
-	{
-		twosComplement(num_copy); //make a flipped copy of num
-		flipped[1] = true;
-	}
-
-	std::vector<int> hits;
-	if (num_copy == 0)
+	//have to make sure of is that num doesn't equal 0.
+	if (num.digits.empty() || (SignificantWords(num.digits) == 1 && num.digits[0] == 0))
 	{
 		//TODO: Need to throw some kind of exception here that breaks the program
 		std::cout << "Division by 0 not possible." << std::endl;
-		return *this;
+		return;
 	}
-	else if (num_copy == 1) return *this;
-	else if (num_copy > * this)
+	if (this->digits.empty()) this->digits.push_back(0);
+
+#if defined(INT_64X_NATIVE_128)
+	//the native division rounds towards 0 and gives the remainder the sign of *this, the same as below. The only division that
+	//overflows is -2^127 / -1.
+	__int128 this_value, num_value;
+	if (LoadNative(this->digits, this_value) && LoadNative(num.digits, num_value) && !(num_value == -1 && this_value == (__int128)((unsigned __int128)1 << 127)))
 	{
-		this->zero();
-		return(*this);
+		StoreNative(this->digits, keep_quotient ? this_value / num_value : this_value % num_value);
+		return;
 	}
+#endif
 
-	long long lead_bit_one = GetLeadBitLocation(*this), lead_bit_two = GetLeadBitLocation(num_copy);
-	long long shift = lead_bit_one - lead_bit_two;
-	int lead_bit_two_start = lead_bit_two;
+	bool this_negative = this->digits.back() >> 63, num_negative = num.digits.back() >> 63;
+	unsigned long long* this_words = workspace.buffer(int_64x_workspace::OPERAND_ONE, this->digits.size());
+	unsigned long long* num_words = workspace.buffer(int_64x_workspace::OPERAND_TWO, num.digits.size());
+	int this_size = CopyMagnitude(this->digits, this_words);
+	int num_size = CopyMagnitude(num.digits, num_words);
 
-
-	num_copy <<= shift; //start by shifting num as far as it can go
-	lead_bit_two += shift;
-
-	while (true)
+	//if num is bigger than *this then the quotient is 0 and the remainder is just *this
+	if (this_size < num_size || (this_size == num_size && CompareWords(this_words, num_words, this_size) < 0))
 	{
-		if (num_copy > * this)
-		{
-			shift--;
-			num_copy >>= 1;
-			lead_bit_two--;
-		}
+		if (keep_quotient) this->zero();
+		return;
+	}
 
-		hits.push_back(shift); //this bit will eventually be flipped in the answer
-		*this -= num_copy;
+	//the remainder is placed after the space DivideWords() needs for its own scratch work
+	unsigned long long* quotient = workspace.buffer(int_64x_workspace::RESULT, this_size - num_size + 1);
+	unsigned long long* scratch = workspace.buffer(int_64x_workspace::SCRATCH, this_size + 2 * num_size + 1);
+	unsigned long long* remainder = scratch + this_size + num_size + 1;
+	DivideWords(quotient, remainder, this_words, this_size, num_words, num_size, scratch);
 
-		lead_bit_one = GetLeadBitLocation(*this);
-		if (lead_bit_one <= lead_bit_two_start) break;
+	if (keep_quotient) StoreMagnitude(this->digits, quotient, this_size - num_size + 1, this_negative ^ num_negative);
+	else StoreMagnitude(this->digits, remainder, num_size, this_negative);
+}
+int_64x operator%(const int_64x& num1, const int_64x& num2)
+{
+	//define modular division using the already defined %= operator, create a copy of num1 inside this function instead of
+	//passing a copy to the function, this reduces the amount of total copies created by 1
+	int_64x num1_copy = num1;
+	num1_copy %= num2;
+	return num1_copy;
+}
 
-		num_copy >>= (lead_bit_two - lead_bit_one);
-		shift -= (lead_bit_two - lead_bit_one);
-		lead_bit_two = lead_bit_one;
-	}
+//Fused Multiply-Add Functions
+void FusedMultiplyAdd(int_64x& acc, const unsigned long long* a, int a_size, bool a_negative, const unsigned long long* b, int b_size, bool b_negative, bool subtract)
+{
+	//Carries out acc += a * b (or acc -= a * b when "subtract" is true) directly in the words of acc. Instead of flipping negative
+	//operands to positive like the *= operator does (which would need a copy of them) the raw words are multiplied as if they were
+	//unsigned and then corrected. A negative number "a" with a_size words has an unsigned value of a + 2^(64 * a_size), so:
+	//
+	//  a * b = Ua * Ub - [a < 0] * Ub * 2^(64 * a_size) - [b < 0] * Ua * 2^(64 * b_size) + [a < 0][b < 0] * 2^(64 * (a_size + b_size))
+	//
+	//acc is first sign extended so that it's one word longer than the full product, everything is then computed modulo the length
+	//of acc which gives the exact answer since the final result is guaranteed to fit.
+	if (acc.digits.empty()) acc.digits.push_back(0);
 
-	//shift num back to it's original position
-	num_copy >>= (lead_bit_two - lead_bit_two_start);
+	int size = ((acc.digits.size() > a_size + b_size) ? acc.digits.size() : a_size + b_size) + 1;
+	acc.digits.resize(size, 0 - (acc.digits.back() >> 63));
+	unsigned long long* dest = acc.digits.data();
 
-	//do one final check to see if the original num can go into *this
-	if (num_copy <= *this)
+	//Ua * Ub, one row for each word of b
+	for (int j = 0; j < b_size; j++)
 	{
-		*this -= num_copy;
-		hits.push_back(0);
+		if (!b[j]) continue;
+		if (subtract) SubtractWordAt(dest, size, j + a_size, MultiplySubtractWords(dest + j, a, a_size, b[j]));
+		else AddWordAt(dest, size, j + a_size, MultiplyAddWords(dest + j, a, a_size, b[j]));
 	}
 
-	//we need to make sure that *this is the correct size to fit the answer in it
-	if (this->digits.size() - 1 > (hits[0] / 64))
+	//the corrections for negative operands
+	if (a_negative)
 	{
-		//*this is too big and needs to be shrunk down
-		this->digits.erase(this->digits.begin() + (hits[0] / 64 + 1), this->digits.end());
+		if (subtract) AddWordAt(dest, size, a_size + b_size, AddWords(dest + a_size, b, b_size));
+		else SubtractWordAt(dest, size, a_size + b_size, SubtractWords(dest + a_size, b, b_size));
 	}
-	else if (this->digits.size() - 1 < (hits[0] / 64))
+	if (b_negative)
 	{
-		//*this is too small and needs to be increased
-		int stop = (hits[0] / 64) - (this->digits.size() - 1); //don't want to use digits.size() in below loop as value will change
-		for (int i = 0; i < stop; i++) this->digits.push_back(0);
+		if (subtract) AddWordAt(dest, size, a_size + b_size, AddWords(dest + b_size, a, a_size));
+		else SubtractWordAt(dest, size, a_size + b_size, SubtractWords(dest + b_size, a, a_size));
 	}
-	for (int i = 0; i < this->digits.size(); i++) this->digits[i] = 0;
-
-	//finally, set all of the correct bits one by one
-	//TODO: I'm sure there's a more efficient way to do this
-	int word = 0;
-	for (int i = 0; i < hits.size(); i++)
+	if (a_negative && b_negative)
 	{
-		word = hits[i] / 64;
-		this->digits[word] |= ((unsigned long long)0x1 << (hits[i] % 64));
+		if (subtract) SubtractWordAt(dest, size, a_size + b_size, 1);
+		else AddWordAt(dest, size, a_size + b_size, 1);
 	}
 
-	//we need to make sure that we haven't changed the polarity of the number by mistake. At this point both of the orignal numbers
-	//were turned into positive values so if the lead bit is now a 1 then we need to add an extra '0' word to the front.
-	if (this->digits.back() & 0x8000000000000000) this->digits.push_back(0);
-
-	//finally, we need to flip the polarity of the answer if only one of the inputs was negative
-	if (flipped[0] ^ flipped[1]) twosComplement(*this);
-
-	return *this;
+	if (!int_64x_lazy_normalization::active()) RemoveRedundantWords(acc.digits);
 }
-int_64x operator/(const int_64x& num1, const int_64x& num2)
+void addmul(int_64x& acc, const int_64x& a, const int_64x& b)
 {
-	//define division using the already defined /= operator, create a copy of num1 inside this function instead of
-	//passing a copy to the function, this reduces the amount of total copies created by 1
-	int_64x num1_copy = num1;
-	num1_copy /= num2;
-	return num1_copy;
-}
-int_64x& int_64x::operator%=(const int_64x& num)
-{
-	//I'm sure there's a better way to do this but for now, just use the same algorithm as division. Once the
-	//division value is obtained, multiply it by "num" and return *this minus that multiplication. This should
-	//work regardless of negative numbers, or if *this is smaller than num.
-
-	//Everything between these lines is directly copied from the /= operator with the exception that functionality
-	//between dividing by 1 and a number bigger than this have been switched.
-	//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
-	int_64x num_copy = num, this_copy = *this; //the actual division is applied to a copy of *this instead of *this itself
-
-	//check to see if either number is negative, if so flip it to a positive number
-	bool flipped[2] = { false, false };
-	if (this_copy.digits.back() & 0x8000000000000000)
+	//acc += a * b. The *= operator copies its operands so that negative numbers can be flipped, and the 50 word limit is there to
+	//keep those copies on the stack. Since FusedMultiplyAdd() never needs a copy the same loop is used for every size. If acc is one
+	//of the operands it's going to be overwritten during the multiplication, so in that case we fall back to the normal operators.
+	if (a.digits.empty() || b.digits.empty()) return;
+	if (&acc == &a || &acc == &b)
 	{
-		twosComplement(this_copy); //flip the copy of *this
-		flipped[0] = true;
+		acc += a * b;
+		return;
 	}
-	if (num_copy.digits.back() & 0x8000000000000000)
+	FusedMultiplyAdd(acc, a.digits.data(), a.digits.size(), a.digits.back() >> 63, b.digits.data(), b.digits.size(), b.digits.back() >> 63, false);
+}
+void submul(int_64x& acc, const int_64x& a, const int_64x& b)
+{
+	//acc -= a * b, see addmul()
+	if (a.digits.empty() || b.digits.empty()) return;
+	if (&acc == &a || &acc == &b)
 	{
-		twosComplement(num_copy); //make a flipped copy of num
-		flipped[1] = true;
+		acc -= a * b;
+		return;
 	}
-
-	std::vector<int> hits;
-	if (num_copy == 0)
+	FusedMultiplyAdd(acc, a.digits.data(), a.digits.size(), a.digits.back() >> 63, b.digits.data(), b.digits.size(), b.digits.back() >> 63, true);
+}
+void addmul_1(int_64x& acc, const int_64x& a, unsigned long long b)
+{
+	//acc += a * b where b is a single unsigned word, so b never needs a correction for being negative
+	if (a.digits.empty() || !b) return;
+	if (&acc == &a)
 	{
-		//TODO: Need to throw some kind of exception here that breaks the program
-		std::cout << "Division by 0 not possible." << std::endl;
-		return *this;
+		acc += a * int_64x(b);
+		return;
 	}
-	else if (num_copy == 1)
+	FusedMultiplyAdd(acc, a.digits.data(), a.digits.size(), a.digits.back() >> 63, &b, 1, false, false);
+}
+void submul_1(int_64x& acc, const int_64x& a, unsigned long long b)
+{
+	//acc -= a * b where b is a single unsigned word
+	if (a.digits.empty() || !b) return;
+	if (&acc == &a)
 	{
-		this->zero();
-		return(*this);
+		acc -= a * int_64x(b);
+		return;
 	}
-	else if (num_copy > this_copy) return *this;
-
-	long long lead_bit_one = GetLeadBitLocation(this_copy), lead_bit_two = GetLeadBitLocation(num_copy);
-	long long shift = lead_bit_one - lead_bit_two;
-	int lead_bit_two_start = lead_bit_two;
+	FusedMultiplyAdd(acc, a.digits.data(), a.digits.size(), a.digits.back() >> 63, &b, 1, false, true);
+}
 
-	num_copy <<= shift;
-	lead_bit_two += shift;
+//Accumulator
+int_64x_accumulator::int_64x_accumulator()
+{
+	//the accumulator always has at least one word to add into
+	words.push_back(0);
+	carries.assign(2, 0);
+}
+int_64x_accumulator::int_64x_accumulator(const int_64x& num)
+{
+	words.push_back(0);
+	carries.assign(2, 0);
+	*this += num;
+}
+void int_64x_accumulator::reserveWords(int size)
+{
+	//extending the words doesn't change the total as long as the new words and carry counts are all 0
+	if (size <= words.size()) return;
+	words.resize(size, 0);
+	carries.resize(size + 1, 0);
+}
+int_64x_accumulator& int_64x_accumulator::operator+=(const int_64x& num)
+{
+	//add the words of num into the partial sums, any overflow just gets counted in the carry for the next word instead of being rippled
+	int size = num.digits.size();
+	if (!size) return *this;
+	reserveWords(size);
 
-	while (true)
+	unsigned long long sum;
+	for (int i = 0; i < size; i++)
 	{
-		if (num_copy > this_copy)
-		{
-			shift--;
-			num_copy >>= 1;
-			lead_bit_two--;
-		}
-
-		hits.push_back(shift);
-		this_copy -= num_copy;
-
-		lead_bit_one = GetLeadBitLocation(this_copy);
-		if (lead_bit_one <= lead_bit_two_start) break;
-
-		num_copy >>= (lead_bit_two - lead_bit_one);
-		shift -= (lead_bit_two - lead_bit_one);
-		lead_bit_two = lead_bit_one;
+		sum = words[i] + num.digits[i];
+		carries[i + 1] += (sum < num.digits[i]);
+		words[i] = sum;
 	}
 
-	num_copy >>= (lead_bit_two - lead_bit_two_start);
+	//a negative number has implied words of all 1's beyond its length which are equal to -2^(64 * size)
+	if (num.digits.back() >> 63) carries[size]--;
+	return *this;
+}
+int_64x_accumulator& int_64x_accumulator::operator+=(int num)
+{
+	return *this += (long long)num;
+}
+int_64x_accumulator& int_64x_accumulator::operator+=(unsigned int num)
+{
+	return *this += (unsigned long long)num;
+}
+int_64x_accumulator& int_64x_accumulator::operator+=(long num)
+{
+	return *this += (long long)num;
+}
+int_64x_accumulator& int_64x_accumulator::operator+=(unsigned long num)
+{
+	return *this += (unsigned long long)num;
+}
+int_64x_accumulator& int_64x_accumulator::operator+=(long long num)
+{
+	unsigned long long sum = words[0] + (unsigned long long)num;
+	carries[1] += (sum < (unsigned long long)num);
+	words[0] = sum;
+	if (num < 0) carries[1]--;
+	return *this;
+}
+int_64x_accumulator& int_64x_accumulator::operator+=(unsigned long long num)
+{
+	unsigned long long sum = words[0] + num;
+	carries[1] += (sum < num);
+	words[0] = sum;
+	return *this;
+}
+int_64x_accumulator& int_64x_accumulator::operator-=(const int_64x& num)
+{
+	//the same as addition but every word that underflows borrows a count from the word above it
+	int size = num.digits.size();
+	if (!size) return *this;
+	reserveWords(size);
 
-	if (num_copy <= this_copy)
+	for (int i = 0; i < size; i++)
 	{
-		this_copy -= num_copy;
-		hits.push_back(0);
+		carries[i + 1] -= (words[i] < num.digits[i]);
+		words[i] -= num.digits[i];
 	}
-	//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
-	//The modular division function deviates slightly from standard division at this point
 
-	if (this_copy.digits.size() - 1 > (hits[0] / 64))
-	{
-		this_copy.digits.erase(this_copy.digits.begin() + (hits[0] / 64 + 1), this_copy.digits.end());
-	}
-	else if (this_copy.digits.size() - 1 < (hits[0] / 64))
-	{
-		int stop = (hits[0] / 64) - (this_copy.digits.size() - 1);
-		for (int i = 0; i < stop; i++) this_copy.digits.push_back(0);
-	}
-	for (int i = 0; i < this_copy.digits.size(); i++) this_copy.digits[i] = 0;
+	//removing the implied 1's of a negative number is the same as adding 2^(64 * size)
+	if (num.digits.back() >> 63) carries[size]++;
+	return *this;
+}
+int_64x_accumulator& int_64x_accumulator::operator-=(long long num)
+{
+	carries[1] -= (words[0] < (unsigned long long)num);
+	words[0] -= (unsigned long long)num;
+	if (num < 0) carries[1]++;
+	return *this;
+}
+int_64x_accumulator& int_64x_accumulator::operator-=(unsigned long long num)
+{
+	carries[1] -= (words[0] < num);
+	words[0] -= num;
+	return *this;
+}
+int_64x_accumulator& int_64x_accumulator::operator-=(int num)
+{
+	return *this -= (long long)num;
+}
+int_64x_accumulator& int_64x_accumulator::operator-=(unsigned int num)
+{
+	return *this -= (unsigned long long)num;
+}
+int_64x_accumulator& int_64x_accumulator::operator-=(long num)
+{
+	return *this -= (long long)num;
+}
+int_64x_accumulator& int_64x_accumulator::operator-=(unsigned long num)
+{
+	return *this -= (unsigned long long)num;
+}
+int_64x int_64x_accumulator::result() const
+{
+	//this is the only place where carries actually get rippled. The answer gets two more words than the partial sums, one for
+	//whatever the carry counts add up to beyond the top word and one to make sure the polarity is correct. Anything rippled past
+	//the final word is dropped which is fine as the total is guaranteed to fit.
+	int_64x answer;
+	answer.digits.assign(words.begin(), words.end());
+	answer.digits.resize(words.size() + 2, 0);
 
-	int word = 0;
-	for (int i = 0; i < hits.size(); i++)
+	unsigned long long* dest = answer.digits.data();
+	int size = answer.digits.size();
+	for (int i = 1; i < carries.size(); i++)
 	{
-		word = hits[i] / 64;
-		this_copy.digits[word] |= ((unsigned long long)0x1 << (hits[i] % 64));
+		if (carries[i] > 0) AddWordAt(dest, size, i, carries[i]);
+		else if (carries[i] < 0) SubtractWordAt(dest, size, i, 0 - (unsigned long long)carries[i]);
 	}
 
-	//we need to make sure that we haven't changed the polarity of the number by mistake. At this point both of the orignal numbers
-	//were turned into positive values so if the lead bit is now a 1 then we need to add an extra '0' word to the front.
-	if (this_copy.digits.back() & 0x8000000000000000) this_copy.digits.push_back(0);
-
-	//finally, we need to flip the polarity of the answer if only one of the inputs was negative
-	if (flipped[0] ^ flipped[1]) twosComplement(this_copy);
-
-	//The original division is complete, multiply the copy of *this by the original number we divided by to see how much less it is
-	//than *this. The difference between the two numbers is the answer to our modular division.
-	this_copy *= num;
+	RemoveRedundantWords(answer.digits);
+	return answer;
+}
+void int_64x_accumulator::clear()
+{
+	//set the running total back to 0, the memory is kept around for the next round of additions
+	for (int i = 0; i < words.size(); i++) words[i] = 0;
+	for (int i = 0; i < carries.size(); i++) carries[i] = 0;
+}
 
-	return (*this -= this_copy);
+//Workspace
+int_64x_workspace::int_64x_workspace()
+{
+	allocation_count = 0;
 }
-int_64x operator%(const int_64x& num1, const int_64x& num2)
+unsigned long long* int_64x_workspace::buffer(int index, int size)
 {
-	//define modular division using the already defined %= operator, create a copy of num1 inside this function instead of
-	//passing a copy to the function, this reduces the amount of total copies created by 1
-	int_64x num1_copy = num1;
-	num1_copy %= num2;
-	return num1_copy;
+	//returns the requested buffer making sure that it has room for at least "size" words. Buffers never shrink, and when they need to
+	//grow they at least double in size so that a workspace used for numbers that slowly get bigger doesn't keep reallocating.
+	std::vector<unsigned long long>& words = buffers[index];
+	if (words.size() < size)
+	{
+		int new_size = 2 * words.size();
+		if (new_size < size) new_size = size;
+		words.resize(new_size);
+		allocation_count++;
+	}
+	return words.data();
+}
+unsigned long long int_64x_workspace::allocations() const
+{
+	return allocation_count;
+}
+void int_64x_workspace::release()
+{
+	//frees all of the memory held by the workspace, the next operation to use it will have to allocate again
+	for (int i = 0; i < BUFFER_COUNT; i++) std::vector<unsigned long long>().swap(buffers[i]);
+}
+int_64x_workspace& int_64x_workspace::local()
+{
+	thread_local int_64x_workspace workspace;
+	return workspace;
 }
 
 //Increment Operators
@@ -930,16 +729,7 @@ int_64x& int_64x::operator<<=(const unsigned int left_shift)
 	}
 
 	//Finally we check to see if there are any superfluous words at the start of the number, if so remove all that apply
-	for (int i = this->digits.size() - 1; i > 0; i--)
-	{
-		//this loop will only activate if there are at least two words in the number
-		if ((this->digits[i] == 0) || (this->digits[i] == -1))
-		{
-			//if the lead word isn't 0 or 0xFFFFFFFFFFFFFFFF then no need to remove it
-			if ((this->digits[i] >> 63) == (this->digits[i - 1] >> 63)) this->digits.erase(this->digits.end() - 1);
-		}
-		else break;
-	}
+	if (!int_64x_lazy_normalization::active()) RemoveRedundantWords(this->digits);
 
 	return *this;
 }
@@ -1129,13 +919,7 @@ int_64x& int_64x::operator &= (const int_64x& num)
 	}
 
 	//the & operation is complete, we just need to make sure that there aren't any redundant words at the front of the final number
-	for (int i = this->digits.size() - 1; i > 0; i--)
-	{
-		if ((this->digits[i] == 0) || (this->digits[i] == -1))
-		{
-			if ((this->digits[i] >> 63) == (this->digits[i - 1] >> 63)) this->digits.erase(this->digits.begin() + i);
-		}
-	}
+	if (!int_64x_lazy_normalization::active()) RemoveRedundantWords(this->digits);
 
 	return *this;
 }
@@ -1148,20 +932,169 @@ int_64x operator&(const int_64x& num1, const int_64x& num2)
 	return num1_copy;
 }
 
-//COMPARISON OPERATORS
-bool operator==(const int_64x& num1, const int_64x& num2)
+//NORMALIZATION
+thread_local int int_64x_lazy_normalization::depth = 0;
+
+int_64x_lazy_normalization::int_64x_lazy_normalization()
+{
+	depth++;
+}
+int_64x_lazy_normalization::~int_64x_lazy_normalization()
+{
+	depth--;
+}
+void int_64x::normalize()
 {
-	//returns true if the numbers are identical, otherwise returns false
+	//removes any redundant lead words that were left behind while lazy normalization was active
+	RemoveRedundantWords(this->digits);
+}
+int SignificantWords(const int_64x_digits& digits)
+{
+	//returns the number of words that digits would have after RemoveRedundantWords() without actually removing them, this
+	//lets the comparison operators work on numbers that haven't been normalized while keeping them const
+	int size = digits.size();
+	while (size > 1)
+	{
+		unsigned long long lead = digits[size - 1];
+		if ((lead != 0 && lead != 0xFFFFFFFFFFFFFFFF) || ((lead ^ digits[size - 2]) >> 63)) break;
+		size--;
+	}
+	return size;
+}
 
-	//first see if the sizes are the same, no need to check if they aren't
-	if (num1.digits.size() != num2.digits.size()) return false;
+//BIT ACCESS FUNCTIONS
+void RemoveRedundantWords(int_64x_digits& digits)
+{
+	//removes any lead words that are 0 (or 0xFFFFFFFFFFFFFFFF) when the word below them already has the same polarity,
+	//this is the same clean up that happens at the end of most of the arithmetic operators
+	while (digits.size() > 1)
+	{
+		unsigned long long lead = digits.back();
+		if ((lead != 0 && lead != 0xFFFFFFFFFFFFFFFF) || ((lead ^ digits[digits.size() - 2]) >> 63)) break;
+		digits.pop_back();
+	}
+}
+bool int_64x::test_bit(const unsigned int bit) const
+{
+	//returns the value of the given bit. Any bit beyond the length of *this is just a copy of the sign bit
+	if (this->digits.empty()) return false;
+
+	unsigned int word = bit / 64;
+	if (word >= this->digits.size()) return this->digits.back() >> 63;
+	return (this->digits[word] >> (bit % 64)) & 1;
+}
+void int_64x::set_bit(const unsigned int bit)
+{
+	//sets the given bit to a 1. If the bit is beyond the end of a positive number then *this is lengthened with 0 words
+	//until the bit fits, for negative numbers every bit beyond the end is already a 1 so nothing needs to happen
+	if (this->digits.empty()) this->digits.push_back(0);
+
+	unsigned int word = bit / 64;
+	unsigned long long polarity = this->digits.back() >> 63;
+	if (word >= this->digits.size())
+	{
+		if (polarity) return;
+		this->digits.resize(word + 1, 0);
+	}
+	this->digits[word] |= ((unsigned long long)1 << (bit % 64));
+
+	//setting the lead bit of a positive number would make it negative so a 0 word gets added to keep it positive, while setting
+	//a bit in a negative number may have made the lead word(s) redundant
+	if (!polarity && (this->digits.back() >> 63)) this->digits.push_back(0);
+	else if (polarity && !int_64x_lazy_normalization::active()) RemoveRedundantWords(this->digits);
+}
+void int_64x::clear_bit(const unsigned int bit)
+{
+	//the opposite of set_bit(). Bits beyond the end of a positive number are already 0, while negative numbers need to be
+	//lengthened with 0xFFFFFFFFFFFFFFFF words until the bit fits
+	if (this->digits.empty()) this->digits.push_back(0);
+
+	unsigned int word = bit / 64;
+	unsigned long long polarity = this->digits.back() >> 63;
+	if (word >= this->digits.size())
+	{
+		if (!polarity) return;
+		this->digits.resize(word + 1, 0xFFFFFFFFFFFFFFFF);
+	}
+	this->digits[word] &= ~((unsigned long long)1 << (bit % 64));
+
+	//clearing the lead bit of a negative number would make it positive so a 0xFFFFFFFFFFFFFFFF word gets added to keep it
+	//negative, while clearing a bit in a positive number may have made the lead word(s) redundant
+	if (polarity && !(this->digits.back() >> 63)) this->digits.push_back(0xFFFFFFFFFFFFFFFF);
+	else if (!polarity && !int_64x_lazy_normalization::active()) RemoveRedundantWords(this->digits);
+}
+void int_64x::flip_bit(const unsigned int bit)
+{
+	if (this->test_bit(bit)) this->clear_bit(bit);
+	else this->set_bit(bit);
+}
+int int_64x::bit_length() const
+{
+	//returns the number of bits needed to represent *this, not including the sign bit. For positive numbers this is the location
+	//of the lead bit plus 1. For negative numbers it's the same thing but for ~*this (so -1 gives 0 and -8 gives 3), which saves
+	//us from having to take the two's complement. Since the lead word is only ever redundant when it's needed to hold the sign
+	//this loop will never look at more than the top two words.
+	if (this->digits.empty()) return 0;
+
+	unsigned long long sign = 0 - (this->digits.back() >> 63);
+	for (int i = this->digits.size() - 1; i >= 0; i--)
+	{
+		unsigned long long word = this->digits[i] ^ sign;
+		if (word) return 64 * i + 64 - CountLeadingZeros(word);
+	}
+	return 0;
+}
+int int_64x::count_trailing_zeros() const
+{
+	//returns the number of 0 bits below the least significant 1. Negating a number in two's complement doesn't change this
+	//so it works the same for positive and negative values. If *this is 0 then 0 is returned.
+	for (int i = 0; i < this->digits.size(); i++)
+	{
+		if (this->digits[i]) return 64 * i + CountTrailingZeros(this->digits[i]);
+	}
+	return 0;
+}
+int int_64x::digits10() const
+{
+	//returns the number of decimal digits in *this (not counting the '-' for negative numbers). If *this fits into a single word
+	//then the answer is exact, otherwise it's estimated from the bit length as floor(bits * log10(2)) + 1. The estimate will never
+	//be too small so it's safe to use for sizing buffers, but it may be too large by 1.
+	static const unsigned long long powers_of_ten[20] = {
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+		10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+		10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL };
 
-	for (int i = 0; i < num1.digits.size(); i++)
+	if (this->digits.empty()) return 1;
+
+	bool negative = this->digits.back() >> 63;
+	if (this->digits.size() == 1)
 	{
-		if (num1.digits[i] != num2.digits[i]) return false;
+		unsigned long long magnitude = negative ? 0 - this->digits[0] : this->digits[0];
+		int digit_count = 1;
+		while (digit_count < 20 && magnitude >= powers_of_ten[digit_count]) digit_count++;
+		return digit_count;
 	}
 
-	return true;
+	//the magnitude of a negative number can need one more bit than bit_length() reports (i.e. -8 needs 4 bits as a positive)
+	unsigned long long bits = this->bit_length() + negative;
+
+	//1292913987 / 2^32 is just above log10(2) so rounding error can only ever push the estimate up
+	return (int)((bits * 1292913987ULL) >> 32) + 1;
+}
+
+//COMPARISON OPERATORS
+bool operator==(const int_64x& num1, const int_64x& num2)
+{
+	//returns true if the numbers are identical, otherwise returns false. Either number may still have redundant lead
+	//words if lazy normalization was used to create it, so only the significant words are compared
+	if (UseFixedKernels(num1.digits.size(), num2.digits.size()))
+		return fixed_comparison_kernels[FixedKernelIndex(num1.digits.size(), num2.digits.size())](num1.digits.data(), num2.digits.data()) == 0;
+
+	//first see if the sizes are the same, no need to check if they aren't
+	int size = SignificantWords(num1.digits);
+	if (size != SignificantWords(num2.digits)) return false;
+
+	return CompareWords(num1.digits.data(), num2.digits.data(), size) == 0;
 }
 bool operator!=(const int_64x& num1, const int_64x& num2)
 {
@@ -1171,15 +1104,23 @@ bool operator!=(const int_64x& num1, const int_64x& num2)
 bool operator<(const int_64x& num1, const int_64x& num2)
 {
 	//returns true if num1 is less than num2, otherwise returns false
+#if defined(INT_64X_NATIVE_128)
+	__int128 num1_value, num2_value;
+	if (LoadNative(num1.digits, num1_value) && LoadNative(num2.digits, num2_value)) return num1_value < num2_value;
+#endif
+
+	//the kernels sign extend the shorter number so they don't care about redundant lead words either
+	if (UseFixedKernels(num1.digits.size(), num2.digits.size()))
+		return fixed_comparison_kernels[FixedKernelIndex(num1.digits.size(), num2.digits.size())](num1.digits.data(), num2.digits.data()) < 0;
+
 	//First check to see if one of the numbers is negative
-	unsigned long long num1_polarity = num1.digits.back() & 0x8000000000000000;
-	unsigned long long num2_polarity = num2.digits.back() & 0x8000000000000000;
-	if (num1_polarity && !num2_polarity) return true;
-	else if (!num1_polarity && num2_polarity) return false;
+	bool num1_negative = num1.digits.back() >> 63, num2_negative = num2.digits.back() >> 63;
+	if (num1_negative != num2_negative) return num1_negative;
 
-	//the polarity is the same, next compare the number of digits
-	if (num1.digits.size() < num2.digits.size()) return true;
-	else if (num2.digits.size() < num1.digits.size()) return false;
+	//the polarity is the same, next compare the number of digits (ignoring any redundant lead words). A longer positive
+	//number is larger, but a longer negative number is further away from 0 so it's smaller.
+	int num1_size = SignificantWords(num1.digits), num2_size = SignificantWords(num2.digits);
+	if (num1_size != num2_size) return (num1_size < num2_size) != num1_negative;
 
 	//if the polarity is the same and the length is the same then every 64-bit word is compared
 	//until one is found to be less than or greater than another one. If all words are the same
@@ -1187,13 +1128,7 @@ bool operator<(const int_64x& num1, const int_64x& num2)
 	//are the opposite of positive numbers in that the smaller the binary representation the more
 	//negative a number gets, but this means that the larger binary representation will then be
 	//larger so nothing has to be differently for negative and positive numbers.
-	for (int i = num1.digits.size() - 1; i >= 0; i--)
-	{
-		if (num1.digits[i] < num2.digits[i]) return true;
-		else if (num1.digits[i] > num2.digits[i]) return false;
-	}
-
-	return false; //the numbers are equal to eachother
+	return CompareWords(num1.digits.data(), num2.digits.data(), num1_size) < 0;
 }
 bool operator>(const int_64x& num1, const int_64x& num2)
 {
@@ -1217,6 +1152,7 @@ int_64x& int_64x::operator=(const int_64x& num)
 	//check for mistaken self assignment
 	if (this == &num) return *this;
 
+	//only the words are copied, *this keeps using its own memory resource
 	this->digits = num.digits;
 	return *this;
 }
@@ -1224,81 +1160,56 @@ int_64x& int_64x::operator=(const int_64x& num)
 //Printing Operations
 std::ostream& operator<<(std::ostream& os, const int_64x& num)
 {
-	int_64x num_copy = num;
-	std::string number_string = num_copy.getNumberString();
-	return os << number_string;
+	return os << num.getNumberString();
+}
+std::string int_64x::getNumberString() const
+{
+	//getNumberString() using the scratch buffers of the current thread
+	return this->getNumberString(int_64x_workspace::local());
 }
-std::string int_64x::getNumberString()
+std::string int_64x::getNumberString(int_64x_workspace& workspace) const
 {
 	//Although we don't store a decimal representation of our number, it will be necessary at times to view the decimal representation.
 	//This function does just that and then returns the representation as a string
 
-	//I can't really think of a good way to convert the current binary representation of the number to base 10 without doing a lot of addition.
-	//Because of this it won't be super efficient to print out a number, however, all mathematics can still happen in binary form so at least that
-	//will be quick. Most likely there won't be a need to print out hundreds of int_64x types at the same time.
+	//The magnitude of the number is copied into the workspace and then repeatedly divided by 10^19, which is the largest power of 10
+	//that fits into a single word. Each remainder is the next 19 decimal digits of the number (starting from the least significant
+	//ones) so a single pass of DivideWordsBySingle() takes care of 19 digits at a time.
+	const unsigned long long ten_nineteen = 10000000000000000000ULL;
 
 	//if the int_64x doesn't have any numbers saved in it then just return a zero
 	if (this->digits.size() == 0) return "0";
 
-	//first check to see if the number is negative, if so then print a negative symbol, then take the two's complement of the number and print that
-	std::string decimal = "";
-	if (this->digits.back() & 0x8000000000000000)
+	unsigned long long* magnitude = workspace.buffer(int_64x_workspace::OPERAND_ONE, this->digits.size());
+	int size = CopyMagnitude(this->digits, magnitude);
+	if (size == 1 && magnitude[0] == 0) return "0";
+
+	//each chunk of 19 digits gets saved in the scratch buffer, a word holds at most 20 decimal digits so 2 chunks per word is plenty
+	unsigned long long* chunks = workspace.buffer(int_64x_workspace::SCRATCH, 2 * size);
+	int chunk_count = 0;
+	while (size)
 	{
-		decimal += '-';
-		twosComplement(*this);
-		decimal += getNumberString();
-		twosComplement(*this);
-		return decimal;
+		chunks[chunk_count++] = DivideWordsBySingle(magnitude, magnitude, size, ten_nineteen);
+		while (size && magnitude[size - 1] == 0) size--;
 	}
 
-	//if there's only 1 unsigned long long int then print as normal as the compiler can handle 64-bit operations
-	//std::vector<unsigned long long*> digs = num.getDigits();
-	if (this->digits.size() == 1) return std::to_string(this->digits[0]);
-
-	//We don't currently know how many digits we need as this value isn't saved, so figure it out logarithmically.
-	int number_length = 64 * this->digits.size() * log10(2) + 1; //add 1 just for a little buffer
-
-	//Create a temporary array to store each number that needs to be printed
-	//also, once we get to numbers greater than 2^64, the physical digits of 2^x will also need to be saved so that we
-	//know what to multiply by
-	int* base_ten = new int[number_length](), * two_power = new int[number_length]();
-	two_power[0] = 1; //2^0 == 1
-	int count = 0; //keeps track of which for of digits we're looking at
-	unsigned long long location = 0x1;
-	int current_power = 0; //represents the current exponent of two_power (i.e. 2^current_power = two_power array)
+	//the most significant chunk is printed as is while every other chunk gets padded out to 19 digits with lead 0's
+	std::string decimal = "";
+	decimal.reserve(19 * chunk_count + 1);
+	if (this->digits.back() & 0x8000000000000000) decimal += '-';
+	decimal += std::to_string(chunks[chunk_count - 1]);
 
-	while (current_power < (64 * this->digits.size() - 1)) //we don't count the lead bit as it represents the number's sign
+	char chunk_digits[19];
+	for (int i = chunk_count - 2; i >= 0; i--)
 	{
-		if (location & this->digits[count])
+		unsigned long long chunk = chunks[i];
+		for (int j = 18; j >= 0; j--)
 		{
-			//we have a hit so add the appropriate power of 2 to the deicmal array
-			AddArrays(base_ten, two_power, number_length);
+			chunk_digits[j] = (chunk % 10) + 48; //adding 48 converts a number to it's associated character
+			chunk /= 10;
 		}
-
-		MultiplyArrayByTwo(two_power, number_length);
-		current_power++;
-
-		if (current_power % 64 == 0)
-		{
-			//we need to move to the next unsigned long long
-			count++;
-			location = 0x1; //reset our location bit
-		}
-		else location <<= 1;
-	}
-
-	//with the base_ten array complete just save each number into a string starting from the back of the array
-	//cycle through until we find the first non-zero digit before saving anything to a string
-	int array_position = number_length - 1;
-
-	while (base_ten[array_position] == 0) array_position--;
-	{
-		//the entire array is zeros so just print out a zero
-		if (array_position < 0) return "0";
+		decimal.append(chunk_digits, 19);
 	}
-	for (int i = array_position; i >= 0; i--) decimal += base_ten[i] + 48; //adding 48 converts a number to it's associated character
-
-	//a very long winded way of printing out a number but currently not sure what other choice I have
 	return decimal;
 }
 void PrintBinary(int_64x num)
@@ -1476,39 +1387,23 @@ void twosComplement(int_64x& num)
 }
 int fastlog2(unsigned long long value)
 {
-	//quickly calculates the integer portion of log2("value"). I'm not entirely sure how this function
-	//works, I shamelessly took it from the internet where they mentioned that it's a DeBrujin-like
-	//algorithm. I added the final part of the return value "* (0xFFFFFFFFFFFFFFFF && value)" so that
-	//the function returns 0 when value is 0 instead of returning 63
-
-	value |= value >> 1;
-	value |= value >> 2;
-	value |= value >> 4;
-	value |= value >> 8;
-	value |= value >> 16;
-	value |= value >> 32;
-	return tab64[((uint64_t)((value - (value >> 1)) * 0x07EDD5E59A4E28C2)) >> 58] * (0xFFFFFFFFFFFFFFFF && value);
+	//quickly calculates the integer portion of log2("value"). This used to be a DeBruijn table lookup but now
+	//it just uses the hardware lzcnt instruction. The function still returns 0 when value is 0 instead of -1
+	return (63 - CountLeadingZeros(value)) * (value != 0);
 }
 int GetLeadBitLocation(int_64x& num)
 {
 	//returns the location of the lead bit of "num", for example the binary number 1001100110 would return 9
 	//this function is only intended to be used with positive int_64x types, however, it will work with negative
 	//values as well(just give unexpected results).
-	unsigned long long number = num.digits.back();
-	int adder = 64 * (num.digits.size() - 1);
-
-	if (number == 0)
-	{
-		//In the case where lead 0's had to be added to the front of a number in order to keep it positive
-		//(i.e. an unsigned number 8 would need 8 bits to create instead of 4 --> 0000 1000) we want to ignore
-		//the lead digits when finding the lead bit location. The lead bit in the above case is 3 and not 7.
-		if (num.digits.size() > 1)
-		{
-			number = num.digits[num.digits.size() - 2];
-			adder -= 64;
-		}
-	}
-	return fastlog2(number) + adder;
+	int word = num.digits.size() - 1;
+
+	//In the case where lead 0's had to be added to the front of a number in order to keep it positive
+	//(i.e. an unsigned number 8 would need 8 bits to create instead of 4 --> 0000 1000) we want to ignore
+	//the lead digits when finding the lead bit location. The lead bit in the above case is 3 and not 7.
+	//There can be more than one of these words if lazy normalization was used to create num.
+	while (word > 0 && num.digits[word] == 0) word--;
+	return fastlog2(num.digits[word]) + 64 * word;
 }
 void int_64x::partialAddition(unsigned long long num, int word)
 {
@@ -1594,6 +1489,359 @@ void unsignedAddition(unsigned long long* num1, unsigned long long num2, int num
 		}
 	}
 }
+unsigned long long AddWords(unsigned long long* dest, const unsigned long long* src, int size)
+{
+	//adds the first "size" words of src to dest and returns the carry out of the final word
+	unsigned long long carry = 0, sum;
+	for (int i = 0; i < size; i++)
+	{
+		sum = dest[i] + carry;
+		carry = (sum < carry);
+		sum += src[i];
+		carry += (sum < src[i]);
+		dest[i] = sum;
+	}
+	return carry;
+}
+unsigned long long SubtractWords(unsigned long long* dest, const unsigned long long* src, int size)
+{
+	//subtracts the first "size" words of src from dest and returns the borrow out of the final word
+	unsigned long long borrow = 0, difference, next_borrow;
+	for (int i = 0; i < size; i++)
+	{
+		difference = dest[i] - src[i];
+		next_borrow = (difference > dest[i]);
+		next_borrow += (difference < borrow);
+		dest[i] = difference - borrow;
+		borrow = next_borrow;
+	}
+	return borrow;
+}
+unsigned long long MultiplyAddWords(unsigned long long* dest, const unsigned long long* src, int size, unsigned long long multiplier)
+{
+	//dest += src * multiplier over "size" words, the high word of the final partial product is returned. Each partial product
+	//is at most (2^64 - 1)^2 so adding two more words to it can never overflow 128 bits.
+	unsigned long long carry = 0, low, high;
+	for (int i = 0; i < size; i++)
+	{
+		low = MultiplyWords(src[i], multiplier, &high);
+		low += carry;
+		high += (low < carry);
+		dest[i] += low;
+		high += (dest[i] < low);
+		carry = high;
+	}
+	return carry;
+}
+unsigned long long MultiplySubtractWords(unsigned long long* dest, const unsigned long long* src, int size, unsigned long long multiplier)
+{
+	//dest -= src * multiplier over "size" words, the amount that still needs to be borrowed from the next word of dest is returned
+	unsigned long long borrow = 0, low, high, current;
+	for (int i = 0; i < size; i++)
+	{
+		low = MultiplyWords(src[i], multiplier, &high);
+		low += borrow;
+		high += (low < borrow);
+		current = dest[i];
+		dest[i] = current - low;
+		high += (current < low);
+		borrow = high;
+	}
+	return borrow;
+}
+unsigned long long MultiplyWordsBySingle(unsigned long long* product, const unsigned long long* num, int size, unsigned long long multiplier)
+{
+	//product = num * multiplier over "size" words, the word that overflows past the end is returned. product and num are allowed
+	//to be the same array.
+	unsigned long long carry = 0, low, high;
+	for (int i = 0; i < size; i++)
+	{
+		low = MultiplyWords(num[i], multiplier, &high);
+		low += carry;
+		high += (low < carry);
+		product[i] = low;
+		carry = high;
+	}
+	return carry;
+}
+void AddWordAt(unsigned long long* dest, int dest_size, int word, unsigned long long num)
+{
+	//like unsignedAddition() but the carry is dropped instead of running off the end of dest
+	for (int i = word; i < dest_size && num; i++)
+	{
+		dest[i] += num;
+		num = (dest[i] < num);
+	}
+}
+void SubtractWordAt(unsigned long long* dest, int dest_size, int word, unsigned long long num)
+{
+	//subtracts num from dest starting at "word" and ripples the borrow towards the end of dest
+	unsigned long long current;
+	for (int i = word; i < dest_size && num; i++)
+	{
+		current = dest[i];
+		dest[i] = current - num;
+		num = (current < num);
+	}
+}
+int CompareWords(const unsigned long long* num1, const unsigned long long* num2, int size)
+{
+	//compares two unsigned word arrays of the same length starting from the most significant word. Returns -1 if num1 is smaller,
+	//1 if num1 is larger and 0 if they're equal
+	for (int i = size - 1; i >= 0; i--)
+	{
+		if (num1[i] != num2[i]) return (num1[i] < num2[i]) ? -1 : 1;
+	}
+	return 0;
+}
+unsigned long long DivideWordsBySingle(unsigned long long* quotient, const unsigned long long* num, int size, unsigned long long divisor)
+{
+	//divides an unsigned word array by a single word, the remainder is returned. The remainder is always less than the divisor so
+	//each step is a single 128-bit by 64-bit division. quotient and num are allowed to be the same array.
+	unsigned long long remainder = 0;
+	for (int i = size - 1; i >= 0; i--) quotient[i] = DivideWordPair(remainder, num[i], divisor, &remainder);
+	return remainder;
+}
+void DivideWords(unsigned long long* quotient, unsigned long long* remainder, const unsigned long long* num, int num_size, const unsigned long long* den, int den_size, unsigned long long* scratch)
+{
+	//Word by word long division of two unsigned arrays (Knuth's Algorithm D). The most significant word of den must be non-zero and
+	//num_size must be at least den_size. quotient needs room for num_size - den_size + 1 words and remainder needs den_size words.
+	//scratch needs room for num_size + den_size + 1 words, it holds copies of num and den that have been shifted left until the lead
+	//bit of den is a 1. This guarantees that the estimate of each quotient word made from the top two words is never more than 2 too
+	//large, and in practice the correction below brings it down to the right value almost every time.
+	if (den_size == 1)
+	{
+		remainder[0] = DivideWordsBySingle(quotient, num, num_size, den[0]);
+		return;
+	}
+
+	int shift = CountLeadingZeros(den[den_size - 1]);
+	unsigned long long* shifted_num = scratch, * shifted_den = scratch + num_size + 1;
+
+	for (int i = den_size - 1; i > 0; i--) shifted_den[i] = (den[i] << shift) | (shift ? den[i - 1] >> (64 - shift) : 0);
+	shifted_den[0] = den[0] << shift;
+	shifted_num[num_size] = shift ? num[num_size - 1] >> (64 - shift) : 0;
+	for (int i = num_size - 1; i > 0; i--) shifted_num[i] = (num[i] << shift) | (shift ? num[i - 1] >> (64 - shift) : 0);
+	shifted_num[0] = num[0] << shift;
+
+	unsigned long long lead = shifted_den[den_size - 1], second = shifted_den[den_size - 2];
+	unsigned long long estimate, estimate_remainder, low, high, borrow;
+	for (int j = num_size - den_size; j >= 0; j--)
+	{
+		//estimate the next quotient word by dividing the top two words of what's left of num by the lead word of den
+		bool remainder_overflow = false;
+		if (shifted_num[j + den_size] >= lead)
+		{
+			estimate = 0xFFFFFFFFFFFFFFFF;
+			estimate_remainder = shifted_num[j + den_size - 1] + lead;
+			remainder_overflow = (estimate_remainder < lead);
+		}
+		else estimate = DivideWordPair(shifted_num[j + den_size], shifted_num[j + den_size - 1], lead, &estimate_remainder);
+
+		//use the second word of den to fix the estimate when it's too big
+		while (!remainder_overflow)
+		{
+			low = MultiplyWords(estimate, second, &high);
+			if (high < estimate_remainder || (high == estimate_remainder && low <= shifted_num[j + den_size - 2])) break;
+			estimate--;
+			estimate_remainder += lead;
+			remainder_overflow = (estimate_remainder < lead);
+		}
+
+		//subtract estimate * den from num, if this goes negative the estimate was still 1 too big so add den back
+		borrow = MultiplySubtractWords(shifted_num + j, shifted_den, den_size, estimate);
+		if (shifted_num[j + den_size] < borrow)
+		{
+			estimate--;
+			shifted_num[j + den_size] += AddWords(shifted_num + j, shifted_den, den_size);
+		}
+		shifted_num[j + den_size] -= borrow;
+		quotient[j] = estimate;
+	}
+
+	//what's left of num is the remainder, it just needs to be shifted back into place
+	for (int i = 0; i < den_size; i++) remainder[i] = (shifted_num[i] >> shift) | (shift ? shifted_num[i + 1] << (64 - shift) : 0);
+}
+void MultiplyMagnitudes(unsigned long long* product, const unsigned long long* num1, int num1_size, const unsigned long long* num2, int num2_size)
+{
+	//product = num1 * num2 where product has room for num1_size + num2_size words and doesn't overlap either number. Each word of
+	//num2 adds one row to the product, and since the top word of each row hasn't been touched yet the carry can just be stored there.
+	for (int i = 0; i < num1_size + num2_size; i++) product[i] = 0;
+	for (int j = 0; j < num2_size; j++)
+	{
+		if (!num2[j]) continue;
+		product[j + num1_size] = MultiplyAddWords(product + j, num1, num1_size, num2[j]);
+	}
+}
+void SquareWords(unsigned long long* product, const unsigned long long* num, int size)
+{
+	//product = num^2 where product has room for 2 * size words and doesn't overlap num. Every cross product num[i] * num[j] shows
+	//up twice in the square, so each one is only calculated once (for i < j), the total is doubled with a single shift and then
+	//the squares of each word are added along the diagonal.
+	for (int i = 0; i < 2 * size; i++) product[i] = 0;
+	for (int i = 0; i < size - 1; i++) product[i + size] = MultiplyAddWords(product + 2 * i + 1, num + i + 1, size - i - 1, num[i]);
+
+	unsigned long long carry = 0, next_carry;
+	for (int i = 0; i < 2 * size; i++)
+	{
+		next_carry = product[i] >> 63;
+		product[i] = (product[i] << 1) | carry;
+		carry = next_carry;
+	}
+
+	unsigned long long low, high, sum;
+	carry = 0;
+	for (int i = 0; i < size; i++)
+	{
+		low = MultiplyWords(num[i], num[i], &high);
+		sum = product[2 * i] + carry;
+		carry = (sum < carry);
+		sum += low;
+		carry += (sum < low);
+		product[2 * i] = sum;
+
+		sum = product[2 * i + 1] + carry;
+		carry = (sum < carry);
+		sum += high;
+		carry += (sum < high);
+		product[2 * i + 1] = sum;
+	}
+}
+void NegateWords(unsigned long long* num, int size)
+{
+	//two's complement of a word array done in place, flip every bit and ripple the + 1 along as we go
+	unsigned long long carry = 1;
+	for (int i = 0; i < size; i++)
+	{
+		num[i] = ~num[i] + carry;
+		carry = carry && (num[i] == 0);
+	}
+}
+int CopyMagnitude(const int_64x_digits& digits, unsigned long long* magnitude)
+{
+	//copies the absolute value of a two's complement number into "magnitude", which needs room for digits.size() words. The
+	//number of significant words in the magnitude is returned (at least 1 even if the number is 0).
+	int size = digits.size();
+	for (int i = 0; i < size; i++) magnitude[i] = digits[i];
+	if (digits.back() >> 63) NegateWords(magnitude, size);
+
+	while (size > 1 && magnitude[size - 1] == 0) size--;
+	return size;
+}
+void StoreMagnitude(int_64x_digits& digits, const unsigned long long* magnitude, int size, bool negative)
+{
+	//the reverse of CopyMagnitude(), digits is set to +/- magnitude. A 0 word is added to the front if needed to keep the lead bit
+	//free for the sign. Resizing digits doesn't allocate anything if it's held a number this big before.
+	while (size > 1 && magnitude[size - 1] == 0) size--;
+
+	int total_size = size + (magnitude[size - 1] >> 63);
+	digits.resize(total_size);
+	for (int i = 0; i < size; i++) digits[i] = magnitude[i];
+	if (total_size > size) digits[size] = 0;
+
+	if (negative && !(size == 1 && magnitude[0] == 0))
+	{
+		NegateWords(digits.data(), total_size);
+
+		//the magnitude of 2^(64n - 1) doesn't need the extra sign word once it's negative
+		if (!int_64x_lazy_normalization::active()) RemoveRedundantWords(digits);
+	}
+}
+
+void StoreWords(int_64x_digits& digits, const unsigned long long* words, int size)
+{
+	//copies a two's complement word array into digits. The lead word is left off if it's just the sign of the word below it, and
+	//every other redundant lead word is left off too unless lazy normalization is active
+	bool trim_all = !int_64x_lazy_normalization::active();
+	while (size > 1)
+	{
+		unsigned long long lead = words[size - 1];
+		if ((lead != 0 && lead != 0xFFFFFFFFFFFFFFFF) || ((lead ^ words[size - 2]) >> 63)) break;
+		size--;
+		if (!trim_all) break;
+	}
+	digits.assign(words, words + size);
+}
+void TrimWords(int_64x_digits& digits)
+{
+	//the same as StoreWords() for a number that's already in digits
+	bool trim_all = !int_64x_lazy_normalization::active();
+	while (digits.size() > 1)
+	{
+		unsigned long long lead = digits.back();
+		if ((lead != 0 && lead != 0xFFFFFFFFFFFFFFFF) || ((lead ^ digits[digits.size() - 2]) >> 63)) break;
+		digits.pop_back();
+		if (!trim_all) break;
+	}
+}
+
+//SIGN FUNCTIONS
+int_64x abs(const int_64x& num)
+{
+	if (num.digits.empty() || !(num.digits.back() >> 63)) return num;
+	return 0 - num;
+}
+
+//POWER FUNCTIONS
+int_64x pow(const int_64x& base, unsigned long long exponent)
+{
+	//Left to right binary exponentiation on the magnitude of base. The answer can't have more than bit_length(|base|) * exponent
+	//bits, so every buffer is grabbed at its final size before the loop starts and the loop itself never allocates. Each bit of
+	//the exponent squares the answer and each 1 bit also multiplies it by the base, the products are written into the spare buffer
+	//and then the two buffers swap places.
+	if (exponent == 0) return 1;
+	if (base.digits.empty()) return 0;
+
+	int_64x_workspace& workspace = int_64x_workspace::local();
+	unsigned long long* base_words = workspace.buffer(int_64x_workspace::OPERAND_ONE, base.digits.size());
+	int base_size = CopyMagnitude(base.digits, base_words);
+	bool negative = (base.digits.back() >> 63) && (exponent & 1);
+
+	unsigned long long base_bits = 64 * (base_size - 1) + 64 - CountLeadingZeros(base_words[base_size - 1]);
+	int max_size = (int)((base_bits * exponent) / 64) + 2;
+	unsigned long long* answer = workspace.buffer(int_64x_workspace::RESULT, max_size);
+	unsigned long long* spare = workspace.buffer(int_64x_workspace::SCRATCH, max_size);
+
+	for (int i = 0; i < base_size; i++) answer[i] = base_words[i];
+	int answer_size = base_size;
+	for (int bit = 62 - CountLeadingZeros(exponent); bit >= 0; bit--)
+	{
+		SquareWords(spare, answer, answer_size);
+		answer_size *= 2;
+		while (answer_size > 1 && spare[answer_size - 1] == 0) answer_size--;
+		std::swap(answer, spare);
+
+		if ((exponent >> bit) & 1)
+		{
+			MultiplyMagnitudes(spare, answer, answer_size, base_words, base_size);
+			answer_size += base_size;
+			while (answer_size > 1 && spare[answer_size - 1] == 0) answer_size--;
+			std::swap(answer, spare);
+		}
+	}
+
+	int_64x result;
+	StoreMagnitude(result.digits, answer, answer_size, negative);
+	return result;
+}
+
+//The powers of 10 are kept in a table for each thread that's filled in as they get asked for. The numbers in the table always use
+//the default memory resource, otherwise asking for a power of 10 inside of an arena scope would leave the table pointing at memory
+//that goes away with the arena.
+static thread_local std::vector<int_64x> powers_of_ten;
+
+int_64x pow10(int exponent)
+{
+	if (exponent < 0) return 0;
+	if (exponent >= powers_of_ten.size() || powers_of_ten[exponent].digits.empty())
+	{
+		int_64x_memory_scope scope(std::pmr::get_default_resource());
+		if (exponent >= powers_of_ten.size()) powers_of_ten.resize(exponent + 1);
+		powers_of_ten[exponent] = pow(int_64x(10), exponent);
+	}
+	return powers_of_ten[exponent];
+}
+
 void int_64x::zero()
 {
 	//turns *this into the number 0
@@ -3,6 +3,11 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <Header_Files/int_64x_memory.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 //The int_64 class is my attempt at making an integer type of arbitrary length. This
 //is accomplished by stringing together unsigned long long types stored in a vector
@@ -27,8 +32,9 @@
 //1. Division and modular division need to throw exceptions when division by 0 occurs
 //2. >>= operator needs to have the same logic as the <<= operator
 //3. Need to add bitwise NOT and XOR operators
-//4. String initialization and printing need to be optimized
-//5. Add versions of each operator that work directly on unsigned longs, should be quicker than converting to int_64x
+//4. Add versions of each operator that work directly on unsigned longs, should be quicker than converting to int_64x
+
+class int_64x_workspace;
 
 //Arithmetic Operator Time Comparisons with a Similar Class
 //These are time comparisons with another C++ big integer type library that I had initially used from online somewhere.
@@ -55,10 +61,11 @@ public:
 	//The digits are in Big Endian format, however, the 64-bit word order is reversed. So a 192 bit word would be ordered like so (where
 	//0 is the LSB and 191 is the MSB):
 	//[63, 62, 61, ... 0], [127, 126, 125 ... 64], [191, 190, 189, ... 128]
-	std::vector<unsigned long long> digits;
+	//The words are allocated from the memory resource that was current on this thread when the number was created, see int_64x_memory.h
+	int_64x_digits digits;
 
 	//CONSTRUCTORS
-	int_64x() = default; //no special default operator
+	int_64x(); //no special default operator, digits is just left empty
 	int_64x(int number); //create a new int_64x type from a signed integer
 	int_64x(unsigned int number); //create a new int_64x type from an unsigned integer
 	int_64x(long long number); //create a new int_64x type from a signed long long integer
@@ -77,13 +84,16 @@ public:
 
 	//Multiplication Operators
 	int_64x& operator*=(const int_64x& num);
+	int_64x& multiply(const int_64x& num, int_64x_workspace& workspace); //*= using the given workspace instead of the thread's own
 	friend int_64x operator*(const int_64x& num1, const int_64x& num2); //TODO: This operator is going really slow with small numbers but not big numbers, investigate and find out why
 	void FastMultiplication(const int_64x& num);
 
 	//Division Operators
-	int_64x& operator/=(const int_64x& num); //TODO: This operator hasn't yet been optimized, come back at some point and spend some time on this
+	int_64x& operator/=(const int_64x& num);
+	int_64x& divide(const int_64x& num, int_64x_workspace& workspace); ///= using the given workspace
 	friend int_64x operator/(const int_64x& num1, const int_64x& num2);
 	int_64x& operator%=(const int_64x& num);
+	int_64x& modulo(const int_64x& num, int_64x_workspace& workspace); //%= using the given workspace
 	friend int_64x operator%(const int_64x& num1, const int_64x& num2);
 
 	//BINARY OPERATORS
@@ -114,10 +124,113 @@ public:
 	//Assignment Operators
 	int_64x& operator=(const int_64x& num);
 	
+	//BIT ACCESS FUNCTIONS
+	//These all work directly on the 64-bit word that holds the requested bit so no shifted copies of *this ever need
+	//to be created. Bit locations past the end of digits are treated as copies of the sign bit, the same way the
+	//bitwise operators treat the implied leading words of a shorter number.
+	bool test_bit(const unsigned int bit) const;
+	void set_bit(const unsigned int bit);
+	void clear_bit(const unsigned int bit);
+	void flip_bit(const unsigned int bit);
+	int bit_length() const; //bits needed to hold the number not including the sign bit (so 0 for both 0 and -1)
+	int count_trailing_zeros() const; //returns 0 when *this is 0
+	int digits10() const; //estimate of the number of decimal digits, never too small but may be 1 too large
+
 	//OTHER FUNCTIONS
-	std::string getNumberString();
+	void normalize(); //removes redundant lead words, only needed after using int_64x_lazy_normalization
+	std::string getNumberString() const;
+	std::string getNumberString(int_64x_workspace& workspace) const;
 	void partialAddition(unsigned long long num, int word); //make this private after testing
 	void zero();
+
+private:
+	void divideMagnitudes(const int_64x& num, int_64x_workspace& workspace, bool keep_quotient);
+};
+
+//The multiplication, division and printing functions all need some temporary memory to hold the magnitudes of their operands
+//and partial answers. Instead of allocating this memory every time, it's borrowed from an int_64x_workspace which holds onto a
+//few word buffers and only ever grows them. Every thread gets its own workspace through local() which is what the operators use,
+//but a workspace can also be created and passed in explicitly (i.e. to keep the memory for one hot loop separate from everything
+//else). allocations() counts how many times a buffer has had to grow, so once a loop has warmed up the workspace this count should
+//stop changing. A workspace isn't thread safe, so it should only ever be used by one thread at a time.
+class int_64x_workspace
+{
+public:
+	enum Buffer { OPERAND_ONE, OPERAND_TWO, RESULT, SCRATCH, MODULAR, BUFFER_COUNT }; //MODULAR is only used by the kernels in int_64x_modular.cpp
+
+	int_64x_workspace();
+	unsigned long long* buffer(int index, int size); //returns the given buffer with room for at least "size" words
+	unsigned long long allocations() const;
+	void release();
+
+	static int_64x_workspace& local(); //the workspace for the current thread
+
+private:
+	std::vector<unsigned long long> buffers[BUFFER_COUNT];
+	unsigned long long allocation_count;
+};
+
+//Almost every operator ends by removing any lead words of 0 (or 0xFFFFFFFFFFFFFFFF) that are no longer needed. In a long chain of
+//calculations this is usually wasted effort as the next operation just adds the words back. Creating an int_64x_lazy_normalization
+//object turns this clean up off for the current thread until the object goes out of scope. Numbers created in the meantime are still
+//correct, they just might have some extra lead words. The comparison operators, division and printing all work with these numbers,
+//and normalize() can be called on any number to clean it up explicitly. Guards can be nested.
+class int_64x_lazy_normalization
+{
+public:
+	int_64x_lazy_normalization();
+	~int_64x_lazy_normalization();
+	int_64x_lazy_normalization(const int_64x_lazy_normalization&) = delete;
+	int_64x_lazy_normalization& operator=(const int_64x_lazy_normalization&) = delete;
+
+	static bool active() { return depth > 0; }
+
+private:
+	static thread_local int depth;
+};
+
+//The int_64x_accumulator class is for adding together a large amount of int_64x types. Every time the += operator is used on an
+//int_64x the carry needs to be rippled all the way through the number, the polarity of the answer needs to be checked and then any
+//redundant words need to be removed at the end. The accumulator instead keeps a carry-save representation of the running total: a
+//vector of words that each addend gets added to, and a second vector that counts how many carries have come out of each word. The
+//carries are never rippled, so adding a number is a single pass over its words. Negative numbers are handled by adding their raw
+//words and then removing a single count from the word just above them (the implied 0xFFFFFFFFFFFFFFFF words in front of a negative
+//number add up to -2^(64 * length)). Nothing gets resolved until result() is called.
+class int_64x_accumulator
+{
+public:
+	//VARIABLES
+	std::vector<unsigned long long> words; //the partial sums, in the same word order as int_64x.digits
+	std::vector<long long> carries; //carries[i] is the number of times 2^(64 * i) still needs to be added to words, always one longer than words
+
+	//CONSTRUCTORS
+	int_64x_accumulator();
+	int_64x_accumulator(const int_64x& num); //start the running total at num
+
+	//ARITHMETIC OPERATORS
+	//every built in integer type gets its own overload (in both directions) so that none of them are ambiguous or get silently
+	//converted to a type with a different sign
+	int_64x_accumulator& operator+=(const int_64x& num);
+	int_64x_accumulator& operator+=(int num);
+	int_64x_accumulator& operator+=(unsigned int num);
+	int_64x_accumulator& operator+=(long num);
+	int_64x_accumulator& operator+=(unsigned long num);
+	int_64x_accumulator& operator+=(long long num);
+	int_64x_accumulator& operator+=(unsigned long long num);
+	int_64x_accumulator& operator-=(const int_64x& num);
+	int_64x_accumulator& operator-=(int num);
+	int_64x_accumulator& operator-=(unsigned int num);
+	int_64x_accumulator& operator-=(long num);
+	int_64x_accumulator& operator-=(unsigned long num);
+	int_64x_accumulator& operator-=(long long num);
+	int_64x_accumulator& operator-=(unsigned long long num);
+
+	//OTHER FUNCTIONS
+	int_64x result() const; //resolves all of the carries and returns the total as a normal int_64x
+	void clear();
+
+private:
+	void reserveWords(int size);
 };
 
 //Related Functions
@@ -129,8 +242,138 @@ void SubtractArrays(int* one, int* two, int elements);
 void twosComplement(int_64x& num);
 int fastlog2(unsigned long long value);
 int GetLeadBitLocation(int_64x &num);
+void RemoveRedundantWords(int_64x_digits& digits);
+int SignificantWords(const int_64x_digits& digits);
 void unsignedAddition(unsigned long long* num1, unsigned long long num2, int num1_size, int word);
 
+//Word Array Kernels
+//These work on raw arrays of unsigned 64-bit words with no concept of polarity, they're the building blocks for the fused
+//multiply-add functions below. The Words functions return the carry (or borrow) out of the top of dest, while the WordAt
+//functions ripple a single word into dest starting at "word" and stop at the end of dest.
+unsigned long long AddWords(unsigned long long* dest, const unsigned long long* src, int size);
+unsigned long long SubtractWords(unsigned long long* dest, const unsigned long long* src, int size);
+unsigned long long MultiplyAddWords(unsigned long long* dest, const unsigned long long* src, int size, unsigned long long multiplier);
+unsigned long long MultiplySubtractWords(unsigned long long* dest, const unsigned long long* src, int size, unsigned long long multiplier);
+void AddWordAt(unsigned long long* dest, int dest_size, int word, unsigned long long num);
+void SubtractWordAt(unsigned long long* dest, int dest_size, int word, unsigned long long num);
+unsigned long long MultiplyWordsBySingle(unsigned long long* product, const unsigned long long* num, int size, unsigned long long multiplier);
+int CompareWords(const unsigned long long* num1, const unsigned long long* num2, int size);
+void MultiplyMagnitudes(unsigned long long* product, const unsigned long long* num1, int num1_size, const unsigned long long* num2, int num2_size);
+void SquareWords(unsigned long long* product, const unsigned long long* num, int size);
+void NegateWords(unsigned long long* num, int size);
+int CopyMagnitude(const int_64x_digits& digits, unsigned long long* magnitude);
+void StoreMagnitude(int_64x_digits& digits, const unsigned long long* magnitude, int size, bool negative);
+void StoreWords(int_64x_digits& digits, const unsigned long long* words, int size);
+void TrimWords(int_64x_digits& digits);
+unsigned long long DivideWordsBySingle(unsigned long long* quotient, const unsigned long long* num, int size, unsigned long long divisor);
+void DivideWords(unsigned long long* quotient, unsigned long long* remainder, const unsigned long long* num, int num_size, const unsigned long long* den, int den_size, unsigned long long* scratch);
+
+//Fused Multiply-Add Functions
+//acc += a * b (addmul) and acc -= a * b (submul) carried out directly in the words of acc, no temporary is created for the
+//product. The _1 versions multiply by a single unsigned 64-bit word.
+void FusedMultiplyAdd(int_64x& acc, const unsigned long long* a, int a_size, bool a_negative, const unsigned long long* b, int b_size, bool b_negative, bool subtract);
+void addmul(int_64x& acc, const int_64x& a, const int_64x& b);
+void submul(int_64x& acc, const int_64x& a, const int_64x& b);
+void addmul_1(int_64x& acc, const int_64x& a, unsigned long long b);
+void submul_1(int_64x& acc, const int_64x& a, unsigned long long b);
+
+//Sign Functions
+int_64x abs(const int_64x& num);
+
+//Power Functions
+//pow() returns base^exponent (with 0^0 = 1). pow10() returns 10^exponent out of a cache that's kept for each thread so asking for
+//the same power a second time is just a copy. For powers of 2 use int_64x(1, exponent), which writes the words directly.
+int_64x pow(const int_64x& base, unsigned long long exponent);
+int_64x pow10(int exponent);
+
+//Hardware Intrinsics
+//These are defined here instead of in int_64x.cpp so that they get inlined everywhere they're used. The first two return 64 when
+//value is 0, which is the same thing the lzcnt and tzcnt instructions do. CountBits() is popcnt.
+inline int CountLeadingZeros(unsigned long long value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	return _BitScanReverse64(&index, value) ? 63 - (int)index : 64;
+#else
+	return value ? __builtin_clzll(value) : 64;
+#endif
+}
+inline int CountTrailingZeros(unsigned long long value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	return _BitScanForward64(&index, value) ? (int)index : 64;
+#else
+	return value ? __builtin_ctzll(value) : 64;
+#endif
+}
+inline int CountBits(unsigned long long value)
+{
+#if defined(_MSC_VER)
+	return (int)__popcnt64(value);
+#else
+	return __builtin_popcountll(value);
+#endif
+}
+
+//Full 64-bit x 64-bit = 128-bit multiplication. The low word is returned and the high word is placed in "high".
+inline unsigned long long MultiplyWords(unsigned long long a, unsigned long long b, unsigned long long* high)
+{
+#if defined(_MSC_VER)
+	return _umul128(a, b, high);
+#else
+	unsigned __int128 product = (unsigned __int128)a * b;
+	*high = (unsigned long long)(product >> 64);
+	return (unsigned long long)product;
+#endif
+}
+
+//Divides the 128-bit number (high, low) by divisor. The quotient is returned and the remainder is placed in "remainder". The
+//caller needs to make sure that high < divisor, otherwise the quotient won't fit into 64 bits.
+inline unsigned long long DivideWordPair(unsigned long long high, unsigned long long low, unsigned long long divisor, unsigned long long* remainder)
+{
+#if defined(_MSC_VER)
+	return _udiv128(high, low, divisor, remainder);
+#else
+	unsigned __int128 dividend = ((unsigned __int128)high << 64) | low;
+	*remainder = (unsigned long long)(dividend % divisor);
+	return (unsigned long long)(dividend / divisor);
+#endif
+}
+
+//Native 128-bit Fast Path
+//A large amount of the numbers that get used in practice fit into one or two words, which is exactly the range of a signed 128-bit
+//integer (two's complement digits of 2 words or less always hold a value from -2^127 to 2^127 - 1). When the compiler has a native
+//128-bit type the arithmetic and comparison operators load numbers this small straight into it and only fall back to the general
+//word by word code when the answer overflows. MSVC doesn't have a 128-bit integer type so there the general code is always used.
+#if defined(__SIZEOF_INT128__)
+#define INT_64X_NATIVE_128
+inline bool LoadNative(const int_64x_digits& digits, __int128& value)
+{
+	//returns false if the number is too long to fit
+	if (digits.size() == 1) value = (long long)digits[0];
+	else if (digits.size() == 2) value = (__int128)(((unsigned __int128)digits[1] << 64) | digits[0]);
+	else return false;
+	return true;
+}
+inline void StoreNative(int_64x_digits& digits, __int128 value)
+{
+	//the high word is only needed if it isn't just the sign of the low word
+	unsigned long long low = (unsigned long long)value, high = (unsigned long long)((unsigned __int128)value >> 64);
+	if (high == 0 - (low >> 63))
+	{
+		digits.resize(1);
+		digits[0] = low;
+	}
+	else
+	{
+		digits.resize(2);
+		digits[0] = low;
+		digits[1] = high;
+	}
+}
+#endif
+
 //Printing Functions
 std::ostream& operator<<(std::ostream& os, const int_64x& num);
 void PrintBinary(int_64x num);
@@ -0,0 +1,392 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <vector>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+//BATCH ARITHMETIC
+//Running the same operation over millions of small numbers with one int_64x at a time means a heap allocation and a pointer to chase
+//for every single number. An int_64x_batch<Limbs> holds a whole array of fixed width numbers of exactly Limbs words each, stored as a
+//structure of arrays: all of the lowest words next to each other, then all of the second words, and so on. limb(i) points to the
+//row of word i for every number in the batch. With that layout the kernels below load the same word of 4 (AVX2) or 8 (AVX-512)
+//different numbers with a single instruction and work on all of them at once.
+//
+//The numbers are two's complement just like int_64x, so each one holds a value from -2^(64 * Limbs - 1) up to 2^(64 * Limbs - 1) - 1.
+//Addition, subtraction and multiplication wrap around mod 2^(64 * Limbs), which is the same whether the numbers are thought of as
+//signed or unsigned, and comparisons are signed. Converting an int_64x into a batch keeps its lowest Limbs words (sign extended if
+//the number is shorter than that).
+//
+//Which instruction set gets used is picked when the file is compiled: AVX-512 if __AVX512F__ is defined, AVX2 if __AVX2__ is
+//defined (i.e. /arch:AVX512 or /arch:AVX2 with MSVC, -mavx512f or -mavx2 with gcc and clang) and plain 64-bit words otherwise. The
+//numbers left over at the end of a batch that don't fill a whole vector always use the plain version.
+typedef std::vector<unsigned long long> int_64x_batch_mask; //one word for each number, all 1 bits for true and 0 for false
+
+template <int Limbs>
+class int_64x_batch
+{
+public:
+	//CONSTRUCTORS
+	int_64x_batch(int count = 0) : words((size_t)Limbs * count, 0), count(count) {}
+	int_64x_batch(const std::vector<int_64x>& nums) : int_64x_batch(nums.size())
+	{
+		for (int i = 0; i < count; i++) set(i, nums[i]);
+	}
+
+	//OTHER FUNCTIONS
+	int size() const { return count; }
+	void resize(int new_count)
+	{
+		//the rows need to be moved apart to make room, any new numbers are 0
+		std::vector<unsigned long long> resized((size_t)Limbs * new_count, 0);
+		int kept = (new_count < count) ? new_count : count;
+		for (int limb = 0; limb < Limbs; limb++)
+			for (int i = 0; i < kept; i++) resized[(size_t)limb * new_count + i] = words[(size_t)limb * count + i];
+		words.swap(resized);
+		count = new_count;
+	}
+	unsigned long long* limb(int index) { return words.data() + (size_t)index * count; }
+	const unsigned long long* limb(int index) const { return words.data() + (size_t)index * count; }
+
+	void set(int element, const int_64x& num)
+	{
+		int size = num.digits.size();
+		unsigned long long sign = (size && (num.digits.back() >> 63)) ? 0xFFFFFFFFFFFFFFFF : 0;
+		for (int i = 0; i < Limbs; i++) limb(i)[element] = (i < size) ? num.digits[i] : sign;
+	}
+	int_64x get(int element) const
+	{
+		unsigned long long number[Limbs];
+		for (int i = 0; i < Limbs; i++) number[i] = limb(i)[element];
+
+		int_64x answer;
+		StoreWords(answer.digits, number, Limbs);
+		return answer;
+	}
+	std::vector<int_64x> to_vector() const
+	{
+		std::vector<int_64x> nums(count);
+		for (int i = 0; i < count; i++) nums[i] = get(i);
+		return nums;
+	}
+
+private:
+	std::vector<unsigned long long> words; //word "limb" of number i is at words[limb * count + i]
+	int count;
+};
+
+//Lanes
+//The kernels are written once on top of a few basic operations on a "vector" of WIDTH words, and each instruction set just supplies
+//those operations. Masks are vectors with all 1 bits or all 0 bits in each lane. AVX2 doesn't have an unsigned 64-bit comparison so
+//the sign bit of both sides gets flipped to turn it into a signed one, and neither instruction set has a full 64-bit x 64-bit
+//multiplication so it gets built out of four 32-bit x 32-bit ones.
+struct BatchLanesScalar
+{
+	typedef unsigned long long vec;
+	static const int WIDTH = 1;
+
+	static vec load(const unsigned long long* source) { return *source; }
+	static void store(unsigned long long* dest, vec value) { *dest = value; }
+	static vec zero() { return 0; }
+	static vec add(vec a, vec b) { return a + b; }
+	static vec subtract(vec a, vec b) { return a - b; }
+	static vec bitAnd(vec a, vec b) { return a & b; }
+	static vec bitOr(vec a, vec b) { return a | b; }
+	static vec select(vec mask, vec a, vec b) { return (mask & a) | (~mask & b); }
+	static vec less(vec a, vec b) { return 0 - (unsigned long long)(a < b); }
+	static vec lessSigned(vec a, vec b) { return 0 - (unsigned long long)((long long)a < (long long)b); }
+	static vec equal(vec a, vec b) { return 0 - (unsigned long long)(a == b); }
+	static vec multiply(vec a, vec b, vec* high) { return MultiplyWords(a, b, high); }
+	static vec multiplyLow(vec a, vec b) { return a * b; }
+};
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+template <typename Ops>
+struct BatchWideMultiply
+{
+	typedef typename Ops::vec Vec;
+
+	//(a_high * 2^32 + a_low) * (b_high * 2^32 + b_low), the middle column is at most 3 * (2^32 - 1) so it can't overflow
+	static Vec multiply(Vec a, Vec b, Vec* high)
+	{
+		Vec low_mask = Ops::set1(0xFFFFFFFF);
+		Vec a_high = Ops::shiftRight(a, 32), b_high = Ops::shiftRight(b, 32);
+		Vec low_low = Ops::multiply32(a, b), low_high = Ops::multiply32(a, b_high);
+		Vec high_low = Ops::multiply32(a_high, b), high_high = Ops::multiply32(a_high, b_high);
+
+		Vec middle = Ops::add(Ops::add(Ops::shiftRight(low_low, 32), Ops::bitAnd(low_high, low_mask)), Ops::bitAnd(high_low, low_mask));
+		*high = Ops::add(Ops::add(high_high, Ops::shiftRight(low_high, 32)), Ops::add(Ops::shiftRight(high_low, 32), Ops::shiftRight(middle, 32)));
+		return Ops::bitOr(Ops::bitAnd(low_low, low_mask), Ops::shiftLeft(middle, 32));
+	}
+	static Vec multiplyLow(Vec a, Vec b)
+	{
+		Vec cross = Ops::add(Ops::multiply32(a, Ops::shiftRight(b, 32)), Ops::multiply32(Ops::shiftRight(a, 32), b));
+		return Ops::add(Ops::multiply32(a, b), Ops::shiftLeft(cross, 32));
+	}
+};
+#endif
+
+#if defined(__AVX2__)
+struct BatchLanesAVX2
+{
+	typedef __m256i vec;
+	static const int WIDTH = 4;
+
+	static vec load(const unsigned long long* source) { return _mm256_loadu_si256((const __m256i*)source); }
+	static void store(unsigned long long* dest, vec value) { _mm256_storeu_si256((__m256i*)dest, value); }
+	static vec zero() { return _mm256_setzero_si256(); }
+	static vec set1(unsigned long long value) { return _mm256_set1_epi64x((long long)value); }
+	static vec add(vec a, vec b) { return _mm256_add_epi64(a, b); }
+	static vec subtract(vec a, vec b) { return _mm256_sub_epi64(a, b); }
+	static vec bitAnd(vec a, vec b) { return _mm256_and_si256(a, b); }
+	static vec bitOr(vec a, vec b) { return _mm256_or_si256(a, b); }
+	static vec shiftLeft(vec a, int bits) { return _mm256_slli_epi64(a, bits); }
+	static vec shiftRight(vec a, int bits) { return _mm256_srli_epi64(a, bits); }
+	static vec multiply32(vec a, vec b) { return _mm256_mul_epu32(a, b); }
+	static vec select(vec mask, vec a, vec b) { return _mm256_blendv_epi8(b, a, mask); }
+	static vec less(vec a, vec b)
+	{
+		vec sign = set1(0x8000000000000000);
+		return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+	}
+	static vec lessSigned(vec a, vec b) { return _mm256_cmpgt_epi64(b, a); }
+	static vec equal(vec a, vec b) { return _mm256_cmpeq_epi64(a, b); }
+	static vec multiply(vec a, vec b, vec* high) { return BatchWideMultiply<BatchLanesAVX2>::multiply(a, b, high); }
+	static vec multiplyLow(vec a, vec b) { return BatchWideMultiply<BatchLanesAVX2>::multiplyLow(a, b); }
+};
+#endif
+
+#if defined(__AVX512F__)
+struct BatchLanesAVX512
+{
+	typedef __m512i vec;
+	static const int WIDTH = 8;
+
+	static vec load(const unsigned long long* source) { return _mm512_loadu_si512((const void*)source); }
+	static void store(unsigned long long* dest, vec value) { _mm512_storeu_si512((void*)dest, value); }
+	static vec zero() { return _mm512_setzero_si512(); }
+	static vec set1(unsigned long long value) { return _mm512_set1_epi64((long long)value); }
+	static vec add(vec a, vec b) { return _mm512_add_epi64(a, b); }
+	static vec subtract(vec a, vec b) { return _mm512_sub_epi64(a, b); }
+	static vec bitAnd(vec a, vec b) { return _mm512_and_si512(a, b); }
+	static vec bitOr(vec a, vec b) { return _mm512_or_si512(a, b); }
+	static vec shiftLeft(vec a, int bits) { return _mm512_slli_epi64(a, bits); }
+	static vec shiftRight(vec a, int bits) { return _mm512_srli_epi64(a, bits); }
+	static vec multiply32(vec a, vec b) { return _mm512_mul_epu32(a, b); }
+	static vec fromMask(__mmask8 mask) { return _mm512_maskz_mov_epi64(mask, set1(0xFFFFFFFFFFFFFFFF)); }
+	static vec select(vec mask, vec a, vec b) { return _mm512_mask_blend_epi64(_mm512_test_epi64_mask(mask, mask), b, a); }
+	static vec less(vec a, vec b) { return fromMask(_mm512_cmplt_epu64_mask(a, b)); }
+	static vec lessSigned(vec a, vec b) { return fromMask(_mm512_cmplt_epi64_mask(a, b)); }
+	static vec equal(vec a, vec b) { return fromMask(_mm512_cmpeq_epu64_mask(a, b)); }
+	static vec multiply(vec a, vec b, vec* high) { return BatchWideMultiply<BatchLanesAVX512>::multiply(a, b, high); }
+	static vec multiplyLow(vec a, vec b) { return BatchWideMultiply<BatchLanesAVX512>::multiplyLow(a, b); }
+};
+typedef BatchLanesAVX512 BatchLanesNative;
+#elif defined(__AVX2__)
+typedef BatchLanesAVX2 BatchLanesNative;
+#else
+typedef BatchLanesScalar BatchLanesNative;
+#endif
+
+//Kernels
+//Each kernel works on the numbers from "first" up to (but not including) "last" WIDTH at a time. The carry, borrow and comparison
+//results are kept as masks, subtracting a mask of all 1 bits is the same as adding 1.
+template <int Limbs, typename Lanes>
+struct BatchKernels
+{
+	typedef typename Lanes::vec vec;
+
+	static void add(int_64x_batch<Limbs>& result, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2, int first, int last)
+	{
+		for (int i = first; i < last; i += Lanes::WIDTH)
+		{
+			vec carry = Lanes::zero();
+			for (int limb = 0; limb < Limbs; limb++)
+			{
+				vec a = Lanes::load(num1.limb(limb) + i);
+				vec sum = Lanes::add(a, Lanes::load(num2.limb(limb) + i));
+				vec overflow = Lanes::less(sum, a);
+				vec carried = Lanes::subtract(sum, carry);
+				carry = Lanes::bitOr(overflow, Lanes::less(carried, sum));
+				Lanes::store(result.limb(limb) + i, carried);
+			}
+		}
+	}
+	static void subtract(int_64x_batch<Limbs>& result, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2, int first, int last)
+	{
+		for (int i = first; i < last; i += Lanes::WIDTH)
+		{
+			vec borrow = Lanes::zero();
+			for (int limb = 0; limb < Limbs; limb++)
+			{
+				vec a = Lanes::load(num1.limb(limb) + i), b = Lanes::load(num2.limb(limb) + i);
+				vec difference = Lanes::subtract(a, b);
+				vec underflow = Lanes::less(a, b);
+				vec borrowed = Lanes::add(difference, borrow);
+				borrow = Lanes::bitOr(underflow, Lanes::less(difference, borrowed));
+				Lanes::store(result.limb(limb) + i, borrowed);
+			}
+		}
+	}
+	static void multiplyLow(int_64x_batch<Limbs>& result, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2, int first, int last)
+	{
+		//schoolbook multiplication that never works out anything at or above word Limbs, so the product of the top words only needs
+		//its low half. The product is built in registers first since result is allowed to be the same batch as num1 or num2.
+		for (int i = first; i < last; i += Lanes::WIDTH)
+		{
+			vec a[Limbs], b[Limbs], product[Limbs];
+			for (int limb = 0; limb < Limbs; limb++)
+			{
+				a[limb] = Lanes::load(num1.limb(limb) + i);
+				b[limb] = Lanes::load(num2.limb(limb) + i);
+				product[limb] = Lanes::zero();
+			}
+
+			for (int j = 0; j < Limbs; j++)
+			{
+				vec carry = Lanes::zero(), high;
+				for (int k = 0; j + k < Limbs - 1; k++)
+				{
+					vec low = Lanes::multiply(a[k], b[j], &high);
+					vec sum = Lanes::add(product[j + k], low);
+					vec overflow = Lanes::less(sum, low);
+					product[j + k] = Lanes::add(sum, carry);
+
+					//word + a * b + carry is never more than 2^128 - 1, so both overflows can be added into high
+					carry = Lanes::subtract(Lanes::subtract(high, overflow), Lanes::less(product[j + k], carry));
+				}
+				product[Limbs - 1] = Lanes::add(product[Limbs - 1], Lanes::add(Lanes::multiplyLow(a[Limbs - 1 - j], b[j]), carry));
+			}
+
+			for (int limb = 0; limb < Limbs; limb++) Lanes::store(result.limb(limb) + i, product[limb]);
+		}
+	}
+	static void less(unsigned long long* mask, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2, int first, int last)
+	{
+		//the top words are compared as signed numbers and the rest only matter while every word above them has been equal
+		for (int i = first; i < last; i += Lanes::WIDTH)
+		{
+			vec a = Lanes::load(num1.limb(Limbs - 1) + i), b = Lanes::load(num2.limb(Limbs - 1) + i);
+			vec result = Lanes::lessSigned(a, b), same = Lanes::equal(a, b);
+			for (int limb = Limbs - 2; limb >= 0; limb--)
+			{
+				a = Lanes::load(num1.limb(limb) + i);
+				b = Lanes::load(num2.limb(limb) + i);
+				result = Lanes::bitOr(result, Lanes::bitAnd(same, Lanes::less(a, b)));
+				same = Lanes::bitAnd(same, Lanes::equal(a, b));
+			}
+			Lanes::store(mask + i, result);
+		}
+	}
+	static void equal(unsigned long long* mask, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2, int first, int last)
+	{
+		for (int i = first; i < last; i += Lanes::WIDTH)
+		{
+			vec same = Lanes::equal(Lanes::load(num1.limb(0) + i), Lanes::load(num2.limb(0) + i));
+			for (int limb = 1; limb < Limbs; limb++) same = Lanes::bitAnd(same, Lanes::equal(Lanes::load(num1.limb(limb) + i), Lanes::load(num2.limb(limb) + i)));
+			Lanes::store(mask + i, same);
+		}
+	}
+	static void select(int_64x_batch<Limbs>& result, const unsigned long long* mask, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2,
+		int first, int last)
+	{
+		for (int i = first; i < last; i += Lanes::WIDTH)
+		{
+			vec choice = Lanes::load(mask + i);
+			for (int limb = 0; limb < Limbs; limb++)
+				Lanes::store(result.limb(limb) + i, Lanes::select(choice, Lanes::load(num1.limb(limb) + i), Lanes::load(num2.limb(limb) + i)));
+		}
+	}
+};
+
+//Batch Functions
+//All of the batches need to be the same size (and a mask needs one word for every number), if they aren't then false is returned and
+//result is left alone. result gets resized to match the inputs if it isn't already and it can be the same batch as either of the
+//inputs. BatchSelect() picks num1 where the mask is true and num2 where it's false.
+template <int Limbs>
+bool BatchSizesMatch(const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	return num1.size() == num2.size();
+}
+template <int Limbs>
+bool BatchSizesMatch(int_64x_batch<Limbs>& result, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	if (!BatchSizesMatch(num1, num2)) return false;
+	if (result.size() != num1.size()) result.resize(num1.size());
+	return true;
+}
+inline int BatchVectorEnd(int count)
+{
+	//the numbers before this point fill whole vectors, the ones after it get the scalar kernels
+	return count - count % BatchLanesNative::WIDTH;
+}
+
+template <int Limbs>
+bool BatchAdd(int_64x_batch<Limbs>& result, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	if (!BatchSizesMatch(result, num1, num2)) return false;
+	int end = BatchVectorEnd(num1.size());
+	BatchKernels<Limbs, BatchLanesNative>::add(result, num1, num2, 0, end);
+	BatchKernels<Limbs, BatchLanesScalar>::add(result, num1, num2, end, num1.size());
+	return true;
+}
+template <int Limbs>
+bool BatchSubtract(int_64x_batch<Limbs>& result, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	if (!BatchSizesMatch(result, num1, num2)) return false;
+	int end = BatchVectorEnd(num1.size());
+	BatchKernels<Limbs, BatchLanesNative>::subtract(result, num1, num2, 0, end);
+	BatchKernels<Limbs, BatchLanesScalar>::subtract(result, num1, num2, end, num1.size());
+	return true;
+}
+template <int Limbs>
+bool BatchMultiplyLow(int_64x_batch<Limbs>& result, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	if (!BatchSizesMatch(result, num1, num2)) return false;
+	int end = BatchVectorEnd(num1.size());
+	BatchKernels<Limbs, BatchLanesNative>::multiplyLow(result, num1, num2, 0, end);
+	BatchKernels<Limbs, BatchLanesScalar>::multiplyLow(result, num1, num2, end, num1.size());
+	return true;
+}
+template <int Limbs>
+bool BatchLess(int_64x_batch_mask& mask, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	if (!BatchSizesMatch(num1, num2)) return false;
+	mask.resize(num1.size());
+	int end = BatchVectorEnd(num1.size());
+	BatchKernels<Limbs, BatchLanesNative>::less(mask.data(), num1, num2, 0, end);
+	BatchKernels<Limbs, BatchLanesScalar>::less(mask.data(), num1, num2, end, num1.size());
+	return true;
+}
+template <int Limbs>
+bool BatchEqual(int_64x_batch_mask& mask, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	if (!BatchSizesMatch(num1, num2)) return false;
+	mask.resize(num1.size());
+	int end = BatchVectorEnd(num1.size());
+	BatchKernels<Limbs, BatchLanesNative>::equal(mask.data(), num1, num2, 0, end);
+	BatchKernels<Limbs, BatchLanesScalar>::equal(mask.data(), num1, num2, end, num1.size());
+	return true;
+}
+template <int Limbs>
+bool BatchCompare(std::vector<int>& result, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	//-1 if num1 < num2, 1 if num1 > num2 and 0 if they're equal, just like the fixed size comparison kernels
+	if (!BatchSizesMatch(num1, num2)) return false;
+	int_64x_batch_mask less_mask, equal_mask;
+	BatchLess(less_mask, num1, num2);
+	BatchEqual(equal_mask, num1, num2);
+	result.resize(less_mask.size());
+	for (int i = 0; i < less_mask.size(); i++) result[i] = less_mask[i] ? -1 : (equal_mask[i] ? 0 : 1);
+	return true;
+}
+template <int Limbs>
+bool BatchSelect(int_64x_batch<Limbs>& result, const int_64x_batch_mask& mask, const int_64x_batch<Limbs>& num1, const int_64x_batch<Limbs>& num2)
+{
+	if (mask.size() != num1.size() || !BatchSizesMatch(result, num1, num2)) return false;
+	int end = BatchVectorEnd(num1.size());
+	BatchKernels<Limbs, BatchLanesNative>::select(result, mask.data(), num1, num2, 0, end);
+	BatchKernels<Limbs, BatchLanesScalar>::select(result, mask.data(), num1, num2, end, num1.size());
+	return true;
+}
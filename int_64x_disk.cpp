@@ -0,0 +1,575 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_disk.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//the most words a single window or multiplication block can have, which keeps every count small enough for the int based word kernels
+const unsigned long long DISK_MAXIMUM_WINDOW = 1ULL << 24;
+static std::atomic<unsigned long long> limb_file_count(0);
+
+//LIMB FILES
+int_64x_limb_file::int_64x_limb_file(const std::string& directory) : words(0)
+{
+	//The file gets a name that's unique to this process and is marked for deletion right away (it's unlinked on POSIX systems and
+	//opened with FILE_FLAG_DELETE_ON_CLOSE on Windows) so it disappears as soon as it's closed, even if the program crashes
+	std::error_code error;
+	std::filesystem::path folder = directory.empty() ? std::filesystem::temp_directory_path(error) : std::filesystem::path(directory);
+#if defined(_WIN32)
+	handle = INVALID_HANDLE_VALUE;
+	unsigned long long process = GetCurrentProcessId();
+#else
+	descriptor = -1;
+	unsigned long long process = getpid();
+#endif
+
+	for (int attempt = 0; attempt < 16 && !error; attempt++)
+	{
+		std::string name = (folder / ("int_64x_" + std::to_string(process) + "_" + std::to_string(limb_file_count++) + ".limbs")).string();
+#if defined(_WIN32)
+		handle = CreateFileA(name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, CREATE_NEW,
+			FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+		if (handle != INVALID_HANDLE_VALUE) return;
+		if (GetLastError() != ERROR_FILE_EXISTS) break;
+#else
+		descriptor = open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (descriptor >= 0)
+		{
+			unlink(name.c_str());
+			return;
+		}
+		if (errno != EEXIST) break;
+#endif
+	}
+}
+int_64x_limb_file::~int_64x_limb_file()
+{
+#if defined(_WIN32)
+	if (handle != INVALID_HANDLE_VALUE) CloseHandle(handle);
+#else
+	if (descriptor >= 0) close(descriptor);
+#endif
+}
+bool int_64x_limb_file::valid() const
+{
+#if defined(_WIN32)
+	return handle != INVALID_HANDLE_VALUE;
+#else
+	return descriptor >= 0;
+#endif
+}
+unsigned long long int_64x_limb_file::size() const
+{
+	return words;
+}
+bool int_64x_limb_file::resize(unsigned long long words)
+{
+	//every window needs to be unmapped before a file can be made shorter on Windows
+	bool resized = false;
+	if (valid())
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER bytes;
+		bytes.QuadPart = (long long)(words * sizeof(unsigned long long));
+		resized = SetFilePointerEx(handle, bytes, nullptr, FILE_BEGIN) && SetEndOfFile(handle);
+#else
+		resized = ftruncate(descriptor, (off_t)(words * sizeof(unsigned long long))) == 0;
+#endif
+	}
+
+	if (!resized) return false;
+	this->words = words;
+	return true;
+}
+void int_64x_limb_file::swap(int_64x_limb_file& other)
+{
+#if defined(_WIN32)
+	std::swap(handle, other.handle);
+#else
+	std::swap(descriptor, other.descriptor);
+#endif
+	std::swap(words, other.words);
+}
+
+//LIMB WINDOWS
+int_64x_limb_window::int_64x_limb_window() : base(nullptr), length(0)
+{
+}
+int_64x_limb_window::~int_64x_limb_window()
+{
+	unmap();
+}
+unsigned long long* int_64x_limb_window::map(const int_64x_limb_file& file, unsigned long long first, unsigned long long count, bool writable)
+{
+	//A mapping has to start on a multiple of the page size (the allocation granularity on Windows), so the window starts a little
+	//before "first" and the pointer that gets handed back is moved up to make up for it
+	unmap();
+	if (!count || first + count > file.size()) return nullptr;
+
+#if defined(_WIN32)
+	SYSTEM_INFO system;
+	GetSystemInfo(&system);
+	unsigned long long granularity = system.dwAllocationGranularity;
+#else
+	unsigned long long granularity = sysconf(_SC_PAGESIZE);
+#endif
+	unsigned long long offset = first * sizeof(unsigned long long), start = offset - offset % granularity;
+	size_t bytes = (size_t)(offset + count * sizeof(unsigned long long) - start);
+
+#if defined(_WIN32)
+	HANDLE mapping = CreateFileMappingA((HANDLE)file.handle, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+	if (mapping)
+	{
+		base = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, (DWORD)(start >> 32), (DWORD)start, bytes);
+		CloseHandle(mapping); //the view keeps the mapping alive
+	}
+#else
+	void* mapped = mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file.descriptor, (off_t)start);
+	if (mapped != MAP_FAILED)
+	{
+		base = mapped;
+		if (!writable) madvise(base, bytes, MADV_SEQUENTIAL);
+	}
+#endif
+
+	if (!base) return nullptr;
+	length = bytes;
+	return (unsigned long long*)((unsigned char*)base + (offset - start));
+}
+void int_64x_limb_window::unmap()
+{
+	if (!base) return;
+#if defined(_WIN32)
+	UnmapViewOfFile(base);
+#else
+	munmap(base, length);
+#endif
+	base = nullptr;
+	length = 0;
+}
+
+//CONSTRUCTORS
+int_64x_disk::int_64x_disk(const int_64x_disk_settings& settings) : negative(false), options(settings), limb_file(new int_64x_limb_file(settings.directory))
+{
+}
+
+//CONVERSION
+bool int_64x_disk::assign(const int_64x_view& num)
+{
+	//the magnitude gets written out a window at a time into a new file, which only replaces the old one once everything's worked
+	int size;
+	const unsigned long long* magnitude = LoadMagnitude(num, int_64x_workspace::local(), int_64x_workspace::OPERAND_ONE, size);
+
+	int_64x_limb_file file(options.directory);
+	if (!file.valid() || !file.resize(size)) return false;
+
+	unsigned long long window_words = DiskWindowWords(options, 1);
+	int_64x_limb_window window;
+	for (unsigned long long position = 0; position < size; position += window_words)
+	{
+		unsigned long long count = std::min(window_words, size - position);
+		unsigned long long* words = window.map(file, position, count, true);
+		if (!words) return false;
+		std::memcpy(words, magnitude + position, count * sizeof(unsigned long long));
+	}
+	window.unmap();
+
+	limb_file->swap(file);
+	negative = num.negative && size;
+	return true;
+}
+bool int_64x_disk::assign(const int_64x_disk& num)
+{
+	if (&num == this) return true;
+
+	unsigned long long size = num.size(), window_words = DiskWindowWords(options, 2);
+	int_64x_limb_file file(options.directory);
+	if (!file.valid() || !file.resize(size)) return false;
+
+	int_64x_limb_window source_window, window;
+	for (unsigned long long position = 0; position < size; position += window_words)
+	{
+		unsigned long long count = std::min(window_words, size - position);
+		const unsigned long long* source = source_window.map(num.limbs(), position, count, false);
+		unsigned long long* words = window.map(file, position, count, true);
+		if (!source || !words) return false;
+		std::memcpy(words, source, count * sizeof(unsigned long long));
+	}
+	window.unmap();
+
+	limb_file->swap(file);
+	negative = num.negative;
+	return true;
+}
+bool int_64x_disk::to_int_64x(int_64x& num) const
+{
+	unsigned long long size = this->size();
+	if (size > INT_MAX) return false;
+	if (!size)
+	{
+		num = 0;
+		return true;
+	}
+
+	int_64x_limb_window window;
+	const unsigned long long* words = window.map(*limb_file, 0, size, false);
+	if (!words) return false;
+	StoreMagnitude(num.digits, words, (int)size, negative);
+	return true;
+}
+
+//OTHER FUNCTIONS
+bool int_64x_disk::valid() const
+{
+	return limb_file->valid();
+}
+unsigned long long int_64x_disk::size() const
+{
+	return limb_file->size();
+}
+bool int_64x_disk::isZero() const
+{
+	return size() == 0;
+}
+void int_64x_disk::negate()
+{
+	//0 is never negative
+	if (!isZero()) negative = !negative;
+}
+const int_64x_disk_settings& int_64x_disk::settings() const
+{
+	return options;
+}
+int_64x_limb_file& int_64x_disk::limbs()
+{
+	return *limb_file;
+}
+const int_64x_limb_file& int_64x_disk::limbs() const
+{
+	return *limb_file;
+}
+
+//STREAMING PASSES
+unsigned long long DiskWindowWords(const int_64x_disk_settings& settings, int streams)
+{
+	//the number of words each stream of a pass gets to map at once
+	unsigned long long words = settings.ram_budget / (streams * sizeof(unsigned long long));
+	return std::min(std::max(words, (unsigned long long)DISK_MINIMUM_WINDOW), DISK_MAXIMUM_WINDOW);
+}
+bool CompareLimbFiles(const int_64x_limb_file& file1, const int_64x_limb_file& file2, unsigned long long window_words, int& comparison)
+{
+	//Neither file has any lead words of 0, so the longer one is bigger. Files of the same length are compared a window at a time from
+	//the top down and the first window that's different decides it.
+	unsigned long long size1 = file1.size(), size2 = file2.size();
+	comparison = 0;
+	if (size1 != size2)
+	{
+		comparison = (size1 < size2) ? -1 : 1;
+		return true;
+	}
+
+	int_64x_limb_window window1, window2;
+	for (unsigned long long end = size1; end > 0 && !comparison;)
+	{
+		unsigned long long count = std::min(window_words, end), start = end - count;
+		const unsigned long long* words1 = window1.map(file1, start, count, false);
+		const unsigned long long* words2 = window2.map(file2, start, count, false);
+		if (!words1 || !words2) return false;
+
+		comparison = CompareWords(words1, words2, (int)count);
+		end = start;
+	}
+	return true;
+}
+bool AddLimbFiles(int_64x_limb_file& answer, const int_64x_limb_file& larger, const int_64x_limb_file& smaller, bool subtract, unsigned long long window_words)
+{
+	//answer = larger +/- smaller where larger is at least as long as smaller (and at least as big when subtracting). The answer gets an
+	//extra word of room for the carry, the position of its top non-zero word is tracked as it gets written so that the file can be
+	//trimmed down at the end without having to read it back.
+	unsigned long long size1 = larger.size(), size2 = smaller.size(), carry = 0, top = 0;
+	if (!answer.resize(size1 + 1)) return false;
+
+	int_64x_limb_window window1, window2, answer_window;
+	for (unsigned long long position = 0; position < size1; position += window_words)
+	{
+		unsigned long long count = std::min(window_words, size1 - position);
+		unsigned long long overlap = (position < size2) ? std::min(count, size2 - position) : 0;
+		const unsigned long long* words1 = window1.map(larger, position, count, false);
+		const unsigned long long* words2 = overlap ? window2.map(smaller, position, overlap, false) : nullptr;
+		unsigned long long* dest = answer_window.map(answer, position, count, true);
+		if (!words1 || (overlap && !words2) || !dest) return false;
+
+		for (unsigned long long i = 0; i < count; i++)
+		{
+			unsigned long long other = (i < overlap) ? words2[i] : 0;
+			if (subtract)
+			{
+				unsigned long long difference = words1[i] - other, borrow = difference > words1[i];
+				dest[i] = difference - carry;
+				carry = borrow | (difference < carry);
+			}
+			else
+			{
+				unsigned long long sum = words1[i] + other, overflow = sum < other;
+				dest[i] = sum + carry;
+				carry = overflow | (dest[i] < carry);
+			}
+			if (dest[i]) top = position + i + 1;
+		}
+	}
+
+	if (carry)
+	{
+		unsigned long long* dest = answer_window.map(answer, size1, 1, true);
+		if (!dest) return false;
+		dest[0] = carry;
+		top = size1 + 1;
+	}
+
+	window1.unmap();
+	window2.unmap();
+	answer_window.unmap();
+	return answer.resize(top);
+}
+bool AddDisks(int_64x_disk& result, const int_64x_disk& num1, const int_64x_disk& num2, bool subtract)
+{
+	//the same as int_64x_sm::addSigned(): matching signs add the magnitudes, otherwise the smaller one comes off of the larger one
+	//and the answer takes the sign of the larger one
+	bool negative1 = num1.negative && !num1.isZero(), negative2 = (num2.negative != subtract) && !num2.isZero();
+	unsigned long long window_words = DiskWindowWords(result.settings(), 3);
+
+	int comparison;
+	if (negative1 == negative2) comparison = (num1.size() >= num2.size()) ? 1 : -1;
+	else if (!CompareLimbFiles(num1.limbs(), num2.limbs(), DiskWindowWords(result.settings(), 2), comparison)) return false;
+
+	const int_64x_disk& larger = (comparison >= 0) ? num1 : num2;
+	const int_64x_disk& smaller = (comparison >= 0) ? num2 : num1;
+	bool negative = (comparison >= 0) ? negative1 : negative2;
+
+	int_64x_limb_file answer(result.settings().directory);
+	if (!answer.valid() || !AddLimbFiles(answer, larger.limbs(), smaller.limbs(), negative1 != negative2, window_words)) return false;
+
+	result.limbs().swap(answer);
+	result.negative = negative && !result.isZero();
+	return true;
+}
+
+//RELATED FUNCTIONS
+bool add(int_64x_disk& result, const int_64x_disk& num1, const int_64x_disk& num2)
+{
+	return AddDisks(result, num1, num2, false);
+}
+bool subtract(int_64x_disk& result, const int_64x_disk& num1, const int_64x_disk& num2)
+{
+	return AddDisks(result, num1, num2, true);
+}
+bool multiply(int_64x_disk& result, const int_64x_disk& num1, const int_64x_disk& num2)
+{
+	//Blocked multiplication, see the top of int_64x_disk.h. Each block of the answer is the low "block" words of the accumulator
+	//once every product that lands on it has been added in, after it's written out the accumulator gets shifted down by a block so
+	//whatever's left over carries into the next one. The accumulator never needs more than 2 * block + 2 words since there are far
+	//fewer than 2^64 products in any one block.
+	unsigned long long size1 = num1.size(), size2 = num2.size(), total = size1 + size2;
+	unsigned long long block = std::min(DiskWindowWords(result.settings(), 4), DISK_MAXIMUM_WINDOW);
+	bool negative = num1.negative != num2.negative;
+
+	int_64x_limb_file answer(result.settings().directory);
+	if (!answer.valid() || !answer.resize(size1 && size2 ? total : 0)) return false;
+	if (!size1 || !size2)
+	{
+		result.limbs().swap(answer);
+		result.negative = false;
+		return true;
+	}
+
+	unsigned long long blocks1 = (size1 + block - 1) / block, blocks2 = (size2 + block - 1) / block, answer_blocks = (total + block - 1) / block;
+	int accumulator_size = (int)(2 * block + 2);
+	std::vector<unsigned long long> accumulator(accumulator_size, 0);
+	unsigned long long* acc = accumulator.data();
+	unsigned long long top = 0;
+
+	int_64x_limb_window window1, window2, answer_window;
+	for (unsigned long long s = 0; s < answer_blocks; s++)
+	{
+		//every pair of blocks with i + j = s, the blocks of num1 are read in order
+		unsigned long long first = (s >= blocks2) ? s - blocks2 + 1 : 0, last = std::min(s, blocks1 - 1);
+		for (unsigned long long i = first; i <= last; i++)
+		{
+			unsigned long long j = s - i;
+			int count1 = (int)std::min(block, size1 - i * block), count2 = (int)std::min(block, size2 - j * block);
+			const unsigned long long* words1 = window1.map(num1.limbs(), i * block, count1, false);
+			const unsigned long long* words2 = window2.map(num2.limbs(), j * block, count2, false);
+			if (!words1 || !words2) return false;
+
+			for (int t = 0; t < count2; t++)
+			{
+				if (words2[t]) AddWordAt(acc, accumulator_size, t + count1, MultiplyAddWords(acc + t, words1, count1, words2[t]));
+			}
+		}
+
+		unsigned long long count = std::min(block, total - s * block);
+		unsigned long long* dest = answer_window.map(answer, s * block, count, true);
+		if (!dest) return false;
+		std::memcpy(dest, acc, count * sizeof(unsigned long long));
+		for (unsigned long long i = count; i > 0; i--)
+		{
+			if (acc[i - 1])
+			{
+				top = s * block + i;
+				break;
+			}
+		}
+
+		std::memmove(acc, acc + block, (block + 2) * sizeof(unsigned long long));
+		std::memset(acc + block + 2, 0, block * sizeof(unsigned long long));
+	}
+
+	window1.unmap();
+	window2.unmap();
+	answer_window.unmap();
+	if (!answer.resize(top)) return false;
+
+	result.limbs().swap(answer);
+	result.negative = negative;
+	return true;
+}
+bool shift_left(int_64x_disk& result, const int_64x_disk& num, unsigned long long left_shift)
+{
+	//the whole words of the shift are already 0 in the new file, so only the words of num need to be written out. The bits that get
+	//pushed out of the top of each word are carried over to the next one, across windows too.
+	unsigned long long size = num.size(), new_words = left_shift / 64, previous = 0;
+	int shift_amount = left_shift % 64;
+	unsigned long long window_words = DiskWindowWords(result.settings(), 2);
+
+	int_64x_limb_file answer(result.settings().directory);
+	if (!answer.valid() || !answer.resize(size ? size + new_words + 1 : 0)) return false;
+
+	int_64x_limb_window window, answer_window;
+	for (unsigned long long position = 0; position < size; position += window_words)
+	{
+		unsigned long long count = std::min(window_words, size - position);
+		const unsigned long long* words = window.map(num.limbs(), position, count, false);
+		unsigned long long* dest = answer_window.map(answer, position + new_words, count, true);
+		if (!words || !dest) return false;
+
+		for (unsigned long long i = 0; i < count; i++)
+		{
+			dest[i] = shift_amount ? (words[i] << shift_amount) | previous : words[i];
+			previous = shift_amount ? words[i] >> (64 - shift_amount) : 0;
+		}
+	}
+
+	//the top word of num isn't 0, so the answer ends on whichever of its last two words isn't 0
+	if (previous)
+	{
+		unsigned long long* dest = answer_window.map(answer, size + new_words, 1, true);
+		if (!dest) return false;
+		dest[0] = previous;
+	}
+	window.unmap();
+	answer_window.unmap();
+	if (size && !answer.resize(size + new_words + (previous ? 1 : 0))) return false;
+
+	result.limbs().swap(answer);
+	result.negative = num.negative && size;
+	return true;
+}
+bool shift_right(int_64x_disk& result, const int_64x_disk& num, unsigned long long right_shift)
+{
+	//Right shifting a two's complement number rounds towards negative infinity, so like int_64x_sm a negative number needs 1 added
+	//to its magnitude if any of the bits that get shifted out were 1's. That's a second pass over the answer, but the carry almost
+	//always stops in the first word.
+	unsigned long long size = num.size(), lost_words = right_shift / 64, top = 0;
+	int shift_amount = right_shift % 64;
+	unsigned long long window_words = DiskWindowWords(result.settings(), 2);
+	bool negative = num.negative && size, lost_bits = false;
+
+	int_64x_limb_window window, answer_window;
+	for (unsigned long long position = 0; position < std::min(lost_words, size) && !lost_bits; position += window_words)
+	{
+		unsigned long long count = std::min(window_words, std::min(lost_words, size) - position);
+		const unsigned long long* words = window.map(num.limbs(), position, count, false);
+		if (!words) return false;
+		for (unsigned long long i = 0; i < count; i++) lost_bits |= (words[i] != 0);
+	}
+
+	unsigned long long new_size = (lost_words < size) ? size - lost_words : 0;
+	int_64x_limb_file answer(result.settings().directory);
+	if (!answer.valid() || !answer.resize(new_size + 1)) return false;
+
+	for (unsigned long long position = 0; position < new_size; position += window_words)
+	{
+		//each window of num reaches one word past the answer's window (unless it's the last one) for the bits shifted in from above
+		unsigned long long count = std::min(window_words, new_size - position);
+		unsigned long long input_count = count + (position + count < new_size);
+		const unsigned long long* words = window.map(num.limbs(), lost_words + position, input_count, false);
+		unsigned long long* dest = answer_window.map(answer, position, count, true);
+		if (!words || !dest) return false;
+
+		if (position == 0 && shift_amount) lost_bits |= (words[0] << (64 - shift_amount)) != 0;
+		for (unsigned long long i = 0; i < count; i++)
+		{
+			unsigned long long next = (i + 1 < input_count) ? words[i + 1] : 0;
+			dest[i] = shift_amount ? (words[i] >> shift_amount) | (next << (64 - shift_amount)) : words[i];
+			if (dest[i]) top = position + i + 1;
+		}
+	}
+
+	if (negative && lost_bits)
+	{
+		unsigned long long carry = 1;
+		for (unsigned long long position = 0; carry && position <= new_size; position += window_words)
+		{
+			unsigned long long count = std::min(window_words, new_size + 1 - position);
+			unsigned long long* dest = answer_window.map(answer, position, count, true);
+			if (!dest) return false;
+			for (unsigned long long i = 0; carry && i < count; i++)
+			{
+				carry = (++dest[i] == 0);
+				top = std::max(top, position + i + 1);
+			}
+		}
+	}
+
+	window.unmap();
+	answer_window.unmap();
+	if (!answer.resize(top)) return false;
+
+	result.limbs().swap(answer);
+	result.negative = negative && top;
+	return true;
+}
+bool CompareDiskMagnitudes(int& result, const int_64x_disk& num1, const int_64x_disk& num2)
+{
+	return CompareLimbFiles(num1.limbs(), num2.limbs(), DiskWindowWords(num1.settings(), 2), result);
+}
+bool compare(int& result, const int_64x_disk& num1, const int_64x_disk& num2)
+{
+	bool negative1 = num1.negative && !num1.isZero(), negative2 = num2.negative && !num2.isZero();
+	if (negative1 != negative2)
+	{
+		result = negative1 ? -1 : 1;
+		return true;
+	}
+
+	int comparison;
+	if (!CompareDiskMagnitudes(comparison, num1, num2)) return false;
+	result = negative1 ? -comparison : comparison;
+	return true;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <Header_Files/int_64x_view.h>
+#include <memory>
+#include <string>
+
+//OUT-OF-CORE NUMBERS
+//An int_64x keeps all of its words in a single vector, so the biggest number it can hold is limited by the amount of memory in the
+//machine. An int_64x_disk keeps the magnitude of its number in a limb file instead (a temporary file of raw little endian words) and
+//only ever maps a window of that file into memory at a time. Every operation streams through its operands from one end to the other:
+//addition, subtraction and shifting go from the lowest word up, comparison goes from the top word down, so the files are always read
+//and written in order and the operating system's read ahead does most of the work.
+//
+//Multiplication is blocked. Both numbers are split into blocks of k words and the product is built up one block at a time from the
+//bottom: block s of the answer is the sum of every product A_i * B_j with i + j = s, plus whatever carried out of block s - 1. Each
+//block of the answer gets written out as soon as it's finished so the answer file is written strictly in order, and at any point only
+//one block of each number and an accumulator of 2k + 2 words need to be in memory. The blocks themselves are multiplied with the same
+//schoolbook kernel int_64x uses, so the running time is still quadratic in the length of the numbers.
+//
+//The ram_budget is the most memory a single operation is allowed to map or allocate at once, it's split evenly between the streams of
+//a pass (three for addition, two for comparison) and decides the block size for multiplication. The limb files are created in
+//directory (the system's temporary directory when it's left empty) and are deleted as soon as they're closed, so nothing is left
+//behind if the program stops early.
+struct int_64x_disk_settings
+{
+	std::string directory;
+	unsigned long long ram_budget = 1ULL << 28; //bytes
+};
+const int DISK_MINIMUM_WINDOW = 64; //no window is ever smaller than this many words, no matter how small ram_budget is
+
+//An int_64x_limb_file is a temporary file of words that's deleted when it's destroyed. Resizing it fills any new words with 0's.
+class int_64x_limb_file
+{
+public:
+	int_64x_limb_file(const std::string& directory);
+	~int_64x_limb_file();
+	int_64x_limb_file(const int_64x_limb_file&) = delete;
+	int_64x_limb_file& operator=(const int_64x_limb_file&) = delete;
+
+	bool valid() const;
+	unsigned long long size() const; //in words
+	bool resize(unsigned long long words);
+	void swap(int_64x_limb_file& other);
+
+private:
+	friend class int_64x_limb_window;
+#if defined(_WIN32)
+	void* handle;
+#else
+	int descriptor;
+#endif
+	unsigned long long words;
+};
+
+//An int_64x_limb_window maps some of the words of a limb file into memory, the words are unmapped when the window is mapped somewhere
+//else or destroyed. On POSIX systems read only windows are mapped with a hint to the operating system that they'll be read in order.
+class int_64x_limb_window
+{
+public:
+	int_64x_limb_window();
+	~int_64x_limb_window();
+	int_64x_limb_window(const int_64x_limb_window&) = delete;
+	int_64x_limb_window& operator=(const int_64x_limb_window&) = delete;
+
+	unsigned long long* map(const int_64x_limb_file& file, unsigned long long first, unsigned long long count, bool writable); //nullptr if it fails
+	void unmap();
+
+private:
+	void* base;
+	size_t length;
+};
+
+class int_64x_disk
+{
+public:
+	//VARIABLES
+	bool negative;
+
+	//CONSTRUCTORS
+	int_64x_disk(const int_64x_disk_settings& settings = int_64x_disk_settings()); //starts out as 0, use assign() to give it a value
+	int_64x_disk(const int_64x_disk&) = delete; //copies need to be made explicitly with assign() since they can take a long time
+	int_64x_disk& operator=(const int_64x_disk&) = delete;
+
+	//CONVERSION
+	bool assign(const int_64x_view& num);
+	bool assign(const int_64x_disk& num);
+	bool to_int_64x(int_64x& num) const; //the whole number needs to fit into memory for this one, false (leaving num alone) if it doesn't
+
+	//OTHER FUNCTIONS
+	bool valid() const; //false if the limb file couldn't be created
+	unsigned long long size() const; //the number of significant words in the magnitude, 0 for the number 0
+	bool isZero() const;
+	void negate();
+	const int_64x_disk_settings& settings() const;
+	int_64x_limb_file& limbs(); //the magnitude, never has any lead words of 0
+	const int_64x_limb_file& limbs() const;
+
+private:
+	int_64x_disk_settings options;
+	std::unique_ptr<int_64x_limb_file> limb_file;
+};
+
+//Related Functions
+//Each of these writes its answer into a new limb file in the directory of result and only swaps it in once everything has worked,
+//so result can be one of the operands. They return false (leaving result alone) if a limb file couldn't be created, grown or mapped.
+//compare() works the same way, it only sets result (to -1, 0 or 1) if every window of both numbers could be mapped.
+//The answers match int_64x_sm: right shifting a negative number rounds towards negative infinity.
+bool add(int_64x_disk& result, const int_64x_disk& num1, const int_64x_disk& num2);
+bool subtract(int_64x_disk& result, const int_64x_disk& num1, const int_64x_disk& num2);
+bool multiply(int_64x_disk& result, const int_64x_disk& num1, const int_64x_disk& num2);
+bool shift_left(int_64x_disk& result, const int_64x_disk& num, unsigned long long left_shift);
+bool shift_right(int_64x_disk& result, const int_64x_disk& num, unsigned long long right_shift);
+bool compare(int& result, const int_64x_disk& num1, const int_64x_disk& num2);
+bool CompareDiskMagnitudes(int& result, const int_64x_disk& num1, const int_64x_disk& num2);
+unsigned long long DiskWindowWords(const int_64x_disk_settings& settings, int streams);
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <array>
+#include <utility>
+
+//Fixed Size Kernels
+//Most of the numbers that int_64x gets used for in practice are somewhere in the 128-bit to 512-bit range. At these sizes the general
+//word by word loops in the arithmetic and comparison operators spend more time on loop control and checking which number runs out of
+//words first than they do on the actual arithmetic. The kernels here are templates on the number of words in each operand, so every
+//loop has a trip count that's known at compile time and every "is this word past the end of the number" check is resolved by the
+//compiler, leaving straight line code. One copy of each kernel is instantiated for every pair of sizes from 1 to FIXED_KERNEL_WORDS
+//and stored in a table, the operators in int_64x.cpp look up the kernel for digits.size() of each operand and only use the general
+//loops for longer numbers.
+//
+//All of the kernels work on two's complement words, an operand shorter than the other is treated as if it were sign extended. Since
+//they only read from the operands and write to a separate result array it's fine for both operands to be the same number.
+
+const int FIXED_KERNEL_WORDS = 8;
+
+typedef void (*FixedKernel)(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2);
+typedef int (*FixedCompareKernel)(const unsigned long long* num1, const unsigned long long* num2);
+
+//result = num1 + num2, result needs room for max(N, M) + 1 words so the sum can never overflow
+template <int N, int M>
+struct FixedAddition
+{
+	static void run(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2)
+	{
+		const int size = (N > M ? N : M) + 1;
+		unsigned long long num1_sign = 0 - (num1[N - 1] >> 63), num2_sign = 0 - (num2[M - 1] >> 63);
+		unsigned long long carry = 0, sum, word;
+		for (int i = 0; i < size; i++)
+		{
+			sum = (i < N ? num1[i] : num1_sign) + carry;
+			carry = (sum < carry);
+			word = (i < M ? num2[i] : num2_sign);
+			sum += word;
+			carry += (sum < word);
+			result[i] = sum;
+		}
+	}
+};
+
+//result = num1 - num2, result needs room for max(N, M) + 1 words
+template <int N, int M>
+struct FixedSubtraction
+{
+	static void run(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2)
+	{
+		const int size = (N > M ? N : M) + 1;
+		unsigned long long num1_sign = 0 - (num1[N - 1] >> 63), num2_sign = 0 - (num2[M - 1] >> 63);
+		unsigned long long borrow = 0, difference, word, next_borrow;
+		for (int i = 0; i < size; i++)
+		{
+			word = (i < N ? num1[i] : num1_sign);
+			difference = word - (i < M ? num2[i] : num2_sign);
+			next_borrow = (difference > word);
+			next_borrow += (difference < borrow);
+			result[i] = difference - borrow;
+			borrow = next_borrow;
+		}
+	}
+};
+
+//result = num1 * num2, result needs room for N + M words. The words are multiplied as if both numbers were unsigned and then the
+//product is fixed up for the signs: reading a negative N word number as unsigned adds 2^(64N) to it, so each negative operand
+//means the other operand gets subtracted back out starting at word N (or M). The signed product always fits in N + M words so
+//anything that falls off the top of the result is supposed to.
+template <int N, int M>
+struct FixedMultiplication
+{
+	static void run(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2)
+	{
+		unsigned long long carry, low, high;
+		for (int i = 0; i < N + M; i++) result[i] = 0;
+		for (int j = 0; j < M; j++)
+		{
+			carry = 0;
+			for (int i = 0; i < N; i++)
+			{
+				low = MultiplyWords(num1[i], num2[j], &high);
+				low += carry;
+				high += (low < carry);
+				result[i + j] += low;
+				high += (result[i + j] < low);
+				carry = high;
+			}
+			result[j + N] = carry;
+		}
+
+		if (num1[N - 1] >> 63) subtractAt<M>(result + N, num2);
+		if (num2[M - 1] >> 63) subtractAt<N>(result + M, num1);
+	}
+
+private:
+	template <int SIZE>
+	static void subtractAt(unsigned long long* dest, const unsigned long long* src)
+	{
+		unsigned long long borrow = 0, difference, next_borrow;
+		for (int i = 0; i < SIZE; i++)
+		{
+			difference = dest[i] - src[i];
+			next_borrow = (difference > dest[i]);
+			next_borrow += (difference < borrow);
+			dest[i] = difference - borrow;
+			borrow = next_borrow;
+		}
+	}
+};
+
+//Returns -1 if num1 < num2, 1 if num1 > num2 and 0 if they're equal. Flipping the sign bit of the lead words turns the signed
+//comparison of the lead words into an unsigned one, all of the lower words are compared as unsigned no matter what the sign is.
+template <int N, int M>
+struct FixedComparison
+{
+	static int run(const unsigned long long* num1, const unsigned long long* num2)
+	{
+		const int size = (N > M ? N : M);
+		unsigned long long num1_sign = 0 - (num1[N - 1] >> 63), num2_sign = 0 - (num2[M - 1] >> 63);
+		unsigned long long num1_word, num2_word;
+		for (int i = size - 1; i >= 0; i--)
+		{
+			num1_word = (i < N ? num1[i] : num1_sign);
+			num2_word = (i < M ? num2[i] : num2_sign);
+			if (i == size - 1)
+			{
+				num1_word ^= 0x8000000000000000;
+				num2_word ^= 0x8000000000000000;
+			}
+			if (num1_word != num2_word) return (num1_word < num2_word) ? -1 : 1;
+		}
+		return 0;
+	}
+};
+
+//Dispatch Tables
+//The kernel for operands of N and M words is at index (N - 1) * FIXED_KERNEL_WORDS + (M - 1). The tables are constexpr so they're
+//filled in at compile time and are safe to use from the constructors of static int_64x objects.
+template <typename Kernel, template <int, int> class Operation, int... I>
+constexpr std::array<Kernel, sizeof...(I)> MakeFixedKernelTable(std::integer_sequence<int, I...>)
+{
+	return {{ &Operation<I / FIXED_KERNEL_WORDS + 1, I % FIXED_KERNEL_WORDS + 1>::run... }};
+}
+
+inline constexpr std::array<FixedKernel, FIXED_KERNEL_WORDS * FIXED_KERNEL_WORDS> fixed_addition_kernels =
+	MakeFixedKernelTable<FixedKernel, FixedAddition>(std::make_integer_sequence<int, FIXED_KERNEL_WORDS * FIXED_KERNEL_WORDS>());
+inline constexpr std::array<FixedKernel, FIXED_KERNEL_WORDS * FIXED_KERNEL_WORDS> fixed_subtraction_kernels =
+	MakeFixedKernelTable<FixedKernel, FixedSubtraction>(std::make_integer_sequence<int, FIXED_KERNEL_WORDS * FIXED_KERNEL_WORDS>());
+inline constexpr std::array<FixedKernel, FIXED_KERNEL_WORDS * FIXED_KERNEL_WORDS> fixed_multiplication_kernels =
+	MakeFixedKernelTable<FixedKernel, FixedMultiplication>(std::make_integer_sequence<int, FIXED_KERNEL_WORDS * FIXED_KERNEL_WORDS>());
+inline constexpr std::array<FixedCompareKernel, FIXED_KERNEL_WORDS * FIXED_KERNEL_WORDS> fixed_comparison_kernels =
+	MakeFixedKernelTable<FixedCompareKernel, FixedComparison>(std::make_integer_sequence<int, FIXED_KERNEL_WORDS * FIXED_KERNEL_WORDS>());
+
+//returns true if numbers of these sizes can use the tables above
+inline bool UseFixedKernels(int num1_size, int num2_size)
+{
+	return (num1_size >= 1 && num1_size <= FIXED_KERNEL_WORDS) && (num2_size >= 1 && num2_size <= FIXED_KERNEL_WORDS);
+}
+inline int FixedKernelIndex(int num1_size, int num2_size)
+{
+	return (num1_size - 1) * FIXED_KERNEL_WORDS + (num2_size - 1);
+}
@@ -0,0 +1,133 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_memory.h>
+#include <cstddef>
+#include <new>
+
+//MEMORY SCOPES
+//nullptr means that the thread hasn't picked a resource so the standard default resource gets used
+static thread_local std::pmr::memory_resource* current_resource = nullptr;
+
+std::pmr::memory_resource* int_64x_memory_resource()
+{
+	return current_resource ? current_resource : std::pmr::get_default_resource();
+}
+int_64x_memory_scope::int_64x_memory_scope(std::pmr::memory_resource* resource)
+{
+	previous = current_resource;
+	current_resource = resource;
+}
+int_64x_memory_scope::~int_64x_memory_scope()
+{
+	current_resource = previous;
+}
+
+//POOL RESOURCE
+//Free blocks are kept in a singly linked list for each size class, the link is stored in the first 8 bytes of the block itself so
+//the lists don't need any memory of their own. When a thread ends its lists get emptied back to delete. Any block that gets freed on
+//the thread after that (i.e. by another thread_local object being destroyed) is deleted right away.
+namespace
+{
+struct PoolBlock
+{
+	PoolBlock* next;
+};
+struct PoolFreeLists
+{
+	PoolBlock* heads[int_64x_pool_resource::SIZE_CLASSES];
+	int counts[int_64x_pool_resource::SIZE_CLASSES];
+	~PoolFreeLists();
+};
+}
+static thread_local PoolFreeLists pool_free_lists;
+static thread_local bool pool_flushed = false;
+
+PoolFreeLists::~PoolFreeLists()
+{
+	for (int i = 0; i < int_64x_pool_resource::SIZE_CLASSES; i++)
+	{
+		while (heads[i])
+		{
+			PoolBlock* block = heads[i];
+			heads[i] = block->next;
+			::operator delete(block);
+		}
+		counts[i] = 0;
+	}
+	pool_flushed = true;
+}
+
+static int PoolSizeClass(size_t bytes)
+{
+	//size class 0 is 16 bytes, 1 is 32 bytes, 2 is 64 bytes, etc.
+	int size_class = 0;
+	while (((size_t)16 << size_class) < bytes) size_class++;
+	return size_class;
+}
+static bool PoolHandles(size_t bytes, size_t alignment)
+{
+	//anything too big or too strictly aligned for the pool is passed along to new and delete
+	return (bytes <= ((size_t)16 << (int_64x_pool_resource::SIZE_CLASSES - 1))) && (alignment <= alignof(std::max_align_t));
+}
+
+int_64x_pool_resource* int_64x_pool_resource::get()
+{
+	static int_64x_pool_resource pool;
+	return &pool;
+}
+int int_64x_pool_resource::cachedBlocks()
+{
+	int total = 0;
+	if (pool_flushed) return total;
+	for (int i = 0; i < SIZE_CLASSES; i++) total += pool_free_lists.counts[i];
+	return total;
+}
+void* int_64x_pool_resource::do_allocate(size_t bytes, size_t alignment)
+{
+	if (!PoolHandles(bytes, alignment)) return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+
+	//reuse a free block of the right size if the thread has one, otherwise get a new block that's the full size of the class
+	int size_class = PoolSizeClass(bytes);
+	if (!pool_flushed)
+	{
+		PoolFreeLists& lists = pool_free_lists;
+		if (lists.heads[size_class])
+		{
+			PoolBlock* block = lists.heads[size_class];
+			lists.heads[size_class] = block->next;
+			lists.counts[size_class]--;
+			return block;
+		}
+	}
+	return ::operator new((size_t)16 << size_class);
+}
+void int_64x_pool_resource::do_deallocate(void* block, size_t bytes, size_t alignment)
+{
+	if (!PoolHandles(bytes, alignment))
+	{
+		std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+		return;
+	}
+
+	int size_class = PoolSizeClass(bytes);
+	if (pool_flushed || pool_free_lists.counts[size_class] >= MAX_CACHED)
+	{
+		::operator delete(block);
+		return;
+	}
+
+	PoolFreeLists& lists = pool_free_lists;
+	PoolBlock* freed = static_cast<PoolBlock*>(block);
+	freed->next = lists.heads[size_class];
+	lists.heads[size_class] = freed;
+	lists.counts[size_class]++;
+}
+bool int_64x_pool_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+	//there's only ever one pool object so memory from the pool can be freed through any other reference to it
+	return this == &other;
+}
+
+//ARENA
+int_64x_arena::int_64x_arena(size_t initial_bytes) : std::pmr::monotonic_buffer_resource(initial_bytes)
+{
+}
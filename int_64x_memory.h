@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+
+//The digits of an int_64x are held in a std::pmr::vector so that the memory for them can come from any std::pmr::memory_resource
+//instead of always going through new and delete. Every int_64x grabs the memory resource of the current thread when it's created
+//and keeps using it for its entire life (assigning one int_64x to another copies the words but not the resource). By default the
+//current resource is std::pmr::get_default_resource(), which is new and delete unless it's been changed with
+//std::pmr::set_default_resource(). An int_64x_memory_scope can be used to switch the current thread over to a different resource,
+//i.e. the pool or the arena below, until the scope ends. Scopes can be nested.
+//
+//CAUTION: any int_64x created inside of a scope needs to be destroyed before the resource it was created with. This is never a problem
+//for the pool as it lives for the entire program, but numbers created with an arena can't outlive the arena (or a call to release()).
+typedef std::pmr::vector<unsigned long long> int_64x_digits;
+
+std::pmr::memory_resource* int_64x_memory_resource(); //the resource that new int_64x types on this thread will use
+
+class int_64x_memory_scope
+{
+public:
+	int_64x_memory_scope(std::pmr::memory_resource* resource);
+	~int_64x_memory_scope();
+	int_64x_memory_scope(const int_64x_memory_scope&) = delete;
+	int_64x_memory_scope& operator=(const int_64x_memory_scope&) = delete;
+
+private:
+	std::pmr::memory_resource* previous;
+};
+
+//The int_64x_pool_resource is a size-class pool made for lots of short lived temporaries. Requests are rounded up to the next power of
+//2 (from 16 bytes up to 32kB) and blocks that get freed are kept on a free list for their size class so the next request of that size
+//can reuse them without touching malloc. Every thread has its own free lists, so there's no locking and no contention between threads.
+//A block that's freed on a different thread than the one that allocated it just ends up on the free list of the thread that freed it.
+//Each thread keeps at most MAX_CACHED blocks of each size, anything beyond that (and anything bigger than 32kB) goes straight back to
+//new and delete. There's only one pool object, the free lists live with the threads, so get() is all that's needed to use it.
+class int_64x_pool_resource : public std::pmr::memory_resource
+{
+public:
+	static const int SIZE_CLASSES = 12; //16 bytes, 32 bytes, ... 32kB
+	static const int MAX_CACHED = 64; //the most free blocks of a single size class a thread will hold onto
+
+	static int_64x_pool_resource* get();
+	static int cachedBlocks(); //the number of free blocks currently held by this thread
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override;
+	void do_deallocate(void* block, size_t bytes, size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+//The int_64x_arena is for batch jobs where a large amount of numbers are created and then all thrown away at the same time. Memory is
+//handed out by bumping a pointer through large chunks and deallocation does nothing, all of the memory is given back at once when the
+//arena is destroyed or release() is called. This is just a std::pmr::monotonic_buffer_resource with a starting chunk size that makes
+//sense for int_64x types. An arena isn't thread safe, so it should only ever be used by one thread at a time.
+class int_64x_arena : public std::pmr::monotonic_buffer_resource
+{
+public:
+	int_64x_arena(size_t initial_bytes = 64 * 1024);
+};
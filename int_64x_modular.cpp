@@ -0,0 +1,453 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_modular.h>
+#include <cassert>
+
+//MONTGOMERY CONTEXT
+montgomery_context::montgomery_context(const int_64x& modulus) : modulus_value(modulus)
+{
+	word_count = 0;
+	modulus_inverse = 0;
+	bool usable = !modulus.digits.empty() && (modulus.digits[0] & 1) && !(modulus.digits.back() >> 63) && !(modulus == 1);
+	assert(usable && "montgomery_context needs an odd modulus greater than 1");
+	if (!usable) return;
+
+	//the modulus is positive so its magnitude is just its words without the extra sign word (if it has one)
+	modulus_words.resize(modulus.digits.size());
+	word_count = CopyMagnitude(modulus.digits, modulus_words.data());
+	modulus_words.resize(word_count);
+	modulus_inverse = NegativeInverseWord(modulus_words[0]);
+
+	//R mod n and R^2 mod n only need to be found once, so it's fine to use the regular operators for them
+	int_64x r = 1;
+	r <<= 64 * word_count;
+	r_mod.resize(word_count);
+	ReduceModulus(r_mod.data(), r, modulus, word_count);
+	r <<= 64 * word_count;
+	r_squared.resize(word_count);
+	ReduceModulus(r_squared.data(), r, modulus, word_count);
+}
+bool montgomery_context::valid() const
+{
+	return word_count > 0;
+}
+int montgomery_context::size() const
+{
+	return word_count;
+}
+const unsigned long long* montgomery_context::modulus() const
+{
+	return modulus_words.data();
+}
+unsigned long long montgomery_context::inverse() const
+{
+	return modulus_inverse;
+}
+void montgomery_context::to_montgomery(unsigned long long* result, const int_64x& num) const
+{
+	//reduce num into the range [0, n) and then multiply by R^2, the Montgomery reduction takes one of the R's back out
+	ReduceModulus(result, num, modulus_value, word_count);
+	this->multiply(result, result, r_squared.data());
+}
+int_64x montgomery_context::from_montgomery(const unsigned long long* num) const
+{
+	//the answer is reduced straight into the digits of the new number, the extra word is 0 and holds the sign if it's needed
+	int_64x answer;
+	answer.digits.assign(word_count + 1, 0);
+	this->reduce(answer.digits.data(), num);
+	RemoveRedundantWords(answer.digits);
+	return answer;
+}
+void montgomery_context::multiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2) const
+{
+	unsigned long long* scratch = int_64x_workspace::local().buffer(int_64x_workspace::MODULAR, word_count + 2);
+	MontgomeryMultiply(result, num1, num2, modulus_words.data(), word_count, modulus_inverse, scratch);
+}
+void montgomery_context::reduce(unsigned long long* result, const unsigned long long* num) const
+{
+	unsigned long long* scratch = int_64x_workspace::local().buffer(int_64x_workspace::MODULAR, word_count + 2);
+	MontgomeryReduce(result, num, modulus_words.data(), word_count, modulus_inverse, scratch);
+}
+void montgomery_context::one(unsigned long long* result) const
+{
+	for (int i = 0; i < word_count; i++) result[i] = r_mod[i];
+}
+int_64x montgomery_context::mulmod(const int_64x& num1, const int_64x& num2) const
+{
+	//(num1 * R) * num2 * R^-1 = num1 * num2, so converting just one of the numbers into Montgomery form gives an answer that's
+	//already back out of it
+	std::vector<unsigned long long> num1_words(word_count), num2_words(word_count);
+	this->to_montgomery(num1_words.data(), num1);
+	ReduceModulus(num2_words.data(), num2, modulus_value, word_count);
+	this->multiply(num1_words.data(), num1_words.data(), num2_words.data());
+
+	int_64x answer;
+	answer.digits.assign(word_count + 1, 0);
+	for (int i = 0; i < word_count; i++) answer.digits[i] = num1_words[i];
+	RemoveRedundantWords(answer.digits);
+	return answer;
+}
+
+//BARRETT CONTEXT
+barrett_context::barrett_context(const int_64x& modulus) : modulus_value(modulus)
+{
+	word_count = 0;
+	bool usable = !modulus.digits.empty() && !(modulus.digits.back() >> 63) && !(modulus == 0);
+	assert(usable && "barrett_context needs a modulus greater than 0");
+	if (!usable) return;
+
+	modulus_words.resize(modulus.digits.size());
+	word_count = CopyMagnitude(modulus.digits, modulus_words.data());
+	modulus_words.resize(word_count);
+
+	//mu = floor(2^(128k) / n) is at most 2^(64(k + 1)), so it always fits into k + 2 words
+	int_64x mu = 1;
+	mu <<= 128 * word_count;
+	mu /= modulus;
+	reciprocal.assign(word_count + 2, 0);
+	for (int i = 0; i < mu.digits.size() && i < word_count + 2; i++) reciprocal[i] = mu.digits[i];
+}
+bool barrett_context::valid() const
+{
+	return word_count > 0;
+}
+int barrett_context::size() const
+{
+	return word_count;
+}
+const unsigned long long* barrett_context::modulus() const
+{
+	return modulus_words.data();
+}
+void barrett_context::reduce(unsigned long long* result, const unsigned long long* num) const
+{
+	unsigned long long* scratch = int_64x_workspace::local().buffer(int_64x_workspace::MODULAR, 5 * word_count + 4);
+	this->reduceWords(result, num, scratch + 2 * word_count);
+}
+void barrett_context::multiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2) const
+{
+	//the full product goes into the bottom 2k words of the scratch buffer and the reduction uses the rest
+	unsigned long long* scratch = int_64x_workspace::local().buffer(int_64x_workspace::MODULAR, 5 * word_count + 4);
+	MultiplyMagnitudes(scratch, num1, word_count, num2, word_count);
+	this->reduceWords(result, scratch, scratch + 2 * word_count);
+}
+int_64x barrett_context::reduce(const int_64x& num) const
+{
+	//negative numbers and numbers with more than 2k words are outside of what the reduction can handle, those are sent to the
+	//regular division instead
+	int num_size = num.digits.size();
+	while (num_size > 1 && num.digits[num_size - 1] == 0) num_size--;
+
+	int_64x answer;
+	answer.digits.assign(word_count + 1, 0);
+	if ((num.digits.back() >> 63) || num_size > 2 * word_count) ReduceModulus(answer.digits.data(), num, modulus_value, word_count);
+	else
+	{
+		unsigned long long* scratch = int_64x_workspace::local().buffer(int_64x_workspace::MODULAR, 5 * word_count + 4);
+		for (int i = 0; i < num_size; i++) scratch[i] = num.digits[i];
+		for (int i = num_size; i < 2 * word_count; i++) scratch[i] = 0;
+		this->reduceWords(answer.digits.data(), scratch, scratch + 2 * word_count);
+	}
+	RemoveRedundantWords(answer.digits);
+	return answer;
+}
+int_64x barrett_context::mulmod(const int_64x& num1, const int_64x& num2) const
+{
+	int_64x product = num1 * num2;
+	return this->reduce(product);
+}
+void barrett_context::reduceWords(unsigned long long* result, const unsigned long long* num, unsigned long long* scratch) const
+{
+	//scratch needs room for 3k + 4 words, the first 2k + 3 hold the quotient estimate and the rest hold the remainder estimate.
+	//num has 2k words and isn't changed.
+	int k = word_count;
+	unsigned long long* quotient = scratch;
+	unsigned long long* remainder = scratch + 2 * k + 3;
+	const unsigned long long* top = num + (k - 1); //floor(num / 2^(64(k - 1))), k + 1 words
+
+	//quotient = top * mu / 2^(64(k + 1)). Partial products that land below word k - 1 can change the answer by at most 1 once
+	//they've been shifted away, so each row starts at the first word of top that reaches word k - 1.
+	for (int i = 0; i < 2 * k + 3; i++) quotient[i] = 0;
+	for (int j = 0; j < k + 2; j++)
+	{
+		if (!reciprocal[j]) continue;
+		int start = (k - 1 - j > 0) ? k - 1 - j : 0;
+		quotient[j + k + 1] = MultiplyAddWords(quotient + j + start, top + start, k + 1 - start, reciprocal[j]);
+	}
+	quotient += k + 1; //the quotient estimate is the top k + 2 words
+
+	//remainder = (num - quotient * n) mod 2^(64(k + 1)), only the bottom k + 1 words of the product are needed so each row is cut
+	//off at word k and whatever gets borrowed out of the top is ignored
+	for (int i = 0; i < k + 1; i++) remainder[i] = num[i];
+	for (int j = 0; j < k; j++) MultiplySubtractWords(remainder + j, quotient, k + 1 - j, modulus_words[j]);
+
+	//the estimate is at most 3 short of the real quotient so the remainder is less than 4n, which always fits into k + 1 words
+	while (remainder[k] || CompareWords(remainder, modulus_words.data(), k) >= 0) remainder[k] -= SubtractWords(remainder, modulus_words.data(), k);
+	for (int i = 0; i < k; i++) result[i] = remainder[i];
+}
+
+//POWM TABLE
+powm_table::powm_table(const int_64x& base, const int_64x& modulus, int window_bits) : window_bits(window_bits)
+{
+	word_count = 0;
+	if (this->window_bits < 1) this->window_bits = 1;
+	bool usable = !modulus.digits.empty() && !(modulus.digits.back() >> 63) && !(modulus == 0);
+	assert(usable && "powm_table needs a modulus greater than 0");
+	if (!usable) return;
+
+	//Montgomery multiplication needs an odd modulus, it also can't be used with a modulus of 1 (but every answer is 0 then anyway)
+	int entries = 1 << this->window_bits;
+	if ((modulus.digits[0] & 1) && !(modulus == 1))
+	{
+		montgomery.reset(new montgomery_context(modulus));
+		word_count = montgomery->size();
+		powers.resize(entries * word_count);
+		montgomery->one(powers.data());
+		montgomery->to_montgomery(powers.data() + word_count, base);
+	}
+	else
+	{
+		barrett.reset(new barrett_context(modulus));
+		word_count = barrett->size();
+		powers.resize(entries * word_count);
+		for (int i = 0; i < word_count; i++) powers[i] = 0;
+		powers[0] = !(modulus == 1);
+		ReduceModulus(powers.data() + word_count, base, modulus, word_count);
+	}
+
+	for (int i = 2; i < entries; i++) this->multiply(powers.data() + i * word_count, powers.data() + (i - 1) * word_count, powers.data() + word_count);
+}
+bool powm_table::valid() const
+{
+	return word_count > 0;
+}
+int powm_table::window() const
+{
+	return window_bits;
+}
+int_64x powm_table::powm(const int_64x& exponent) const
+{
+	if (!this->valid()) return 0;
+	if (exponent.digits.back() >> 63) return 0;
+
+	//the answer is built up in the OPERAND_ONE buffer of the workspace, the reduction kernels only use the MODULAR buffer so it's
+	//safe to hold onto this pointer the whole time
+	unsigned long long* answer = int_64x_workspace::local().buffer(int_64x_workspace::OPERAND_ONE, word_count);
+	for (int i = 0; i < word_count; i++) answer[i] = powers[i];
+
+	//Scan the exponent from the lead bit down. A 0 bit just squares the answer, a 1 bit starts a window that's extended as far as
+	//window_bits allows and then pulled back to the last 1 bit in it. The answer gets squared once per bit of the window and then
+	//multiplied by the table entry for the bits in the window. Squaring is skipped until the first window since the answer is 1.
+	bool started = false;
+	int bit = exponent.bit_length() - 1;
+	while (bit >= 0)
+	{
+		if (!exponent.test_bit(bit))
+		{
+			if (started) this->multiply(answer, answer, answer);
+			bit--;
+			continue;
+		}
+
+		int low = bit - window_bits + 1;
+		if (low < 0) low = 0;
+		while (!exponent.test_bit(low)) low++;
+
+		int value = 0;
+		for (int i = bit; i >= low; i--)
+		{
+			value = (value << 1) | exponent.test_bit(i);
+			if (started) this->multiply(answer, answer, answer);
+		}
+		this->multiply(answer, answer, powers.data() + value * word_count);
+		started = true;
+		bit = low - 1;
+	}
+
+	return this->toInt64x(answer);
+}
+int_64x powm_table::powm_sec(const int_64x& exponent) const
+{
+	if (!this->valid()) return 0;
+	if (exponent.digits.back() >> 63) return 0;
+
+	unsigned long long* answer = int_64x_workspace::local().buffer(int_64x_workspace::OPERAND_ONE, word_count);
+	unsigned long long* selected = int_64x_workspace::local().buffer(int_64x_workspace::OPERAND_TWO, word_count);
+	for (int i = 0; i < word_count; i++) answer[i] = powers[i];
+
+	//the exponent is split into windows starting from the bottom, so the top window is the one that can be short
+	int entries = 1 << window_bits, bits = 64 * exponent.digits.size();
+	int top = ((bits - 1) / window_bits) * window_bits;
+	for (int low = top; low >= 0; low -= window_bits)
+	{
+		int value = 0;
+		for (int i = window_bits - 1; i >= 0; i--)
+		{
+			this->multiply(answer, answer, answer);
+			value = (value << 1) | exponent.test_bit(low + i);
+		}
+
+		//every entry is read and masked off so that the entry that actually gets used can't be seen from the memory accesses. This
+		//also means that value = 0 still gets a multiplication (by 1).
+		for (int i = 0; i < word_count; i++) selected[i] = 0;
+		for (int entry = 0; entry < entries; entry++)
+		{
+			unsigned long long mask = 0 - (unsigned long long)(entry == value);
+			const unsigned long long* power = powers.data() + entry * word_count;
+			for (int i = 0; i < word_count; i++) selected[i] |= power[i] & mask;
+		}
+		this->multiply(answer, answer, selected);
+	}
+
+	return this->toInt64x(answer);
+}
+void powm_table::multiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2) const
+{
+	if (montgomery) montgomery->multiply(result, num1, num2);
+	else barrett->multiply(result, num1, num2);
+}
+int_64x powm_table::toInt64x(const unsigned long long* num) const
+{
+	if (montgomery) return montgomery->from_montgomery(num);
+
+	int_64x answer;
+	answer.digits.assign(word_count + 1, 0);
+	for (int i = 0; i < word_count; i++) answer.digits[i] = num[i];
+	RemoveRedundantWords(answer.digits);
+	return answer;
+}
+
+//EXPONENTIATION FUNCTIONS
+int_64x powm(const int_64x& base, const int_64x& exponent, const int_64x& modulus)
+{
+	powm_table table(base, modulus, PowmWindowBits(exponent.bit_length()));
+	return table.powm(exponent);
+}
+int_64x powm_sec(const int_64x& base, const int_64x& exponent, const int_64x& modulus)
+{
+	//the window size can only depend on the length of the exponent, not on its value
+	powm_table table(base, modulus, PowmWindowBits(64 * exponent.digits.size()));
+	return table.powm_sec(exponent);
+}
+
+//HELPER FUNCTIONS
+void ReduceModulus(unsigned long long* result, const int_64x& num, const int_64x& modulus, int size)
+{
+	//result = num mod modulus in the range [0, modulus) written out to "size" words. Numbers that are already in range (which
+	//is almost always the case) are just copied, anything else needs a division.
+	if (!(num.digits.back() >> 63) && num < modulus)
+	{
+		int num_size = num.digits.size() < size ? num.digits.size() : size; //any words past "size" are just the 0 sign word
+		for (int i = 0; i < num_size; i++) result[i] = num.digits[i];
+		for (int i = num_size; i < size; i++) result[i] = 0;
+		return;
+	}
+
+	int_64x remainder = num % modulus;
+	if (remainder.digits.back() >> 63) remainder += modulus;
+	int remainder_size = remainder.digits.size() < size ? remainder.digits.size() : size;
+	for (int i = 0; i < remainder_size; i++) result[i] = remainder.digits[i];
+	for (int i = remainder_size; i < size; i++) result[i] = 0;
+}
+unsigned long long NegativeInverseWord(unsigned long long num)
+{
+	//Newton's method for the inverse of an odd number mod 2^64. Any odd number is its own inverse mod 8 so the starting guess is
+	//good to 3 bits, and every step doubles the number of good bits (3, 6, 12, 24, 48, 96).
+	unsigned long long inverse = num;
+	for (int i = 0; i < 5; i++) inverse *= 2 - num * inverse;
+	return 0 - inverse;
+}
+void MontgomeryStep(unsigned long long* scratch, const unsigned long long* modulus, int size, unsigned long long inverse)
+{
+	//adds m * modulus to the size + 2 word total in scratch, where m is picked so that the bottom word of the total becomes 0.
+	//That word gets dropped by shifting everything down one word as the multiple of the modulus is added.
+	unsigned long long m = scratch[0] * inverse, carry, low, high;
+	low = MultiplyWords(m, modulus[0], &high);
+	low += scratch[0];
+	carry = high + (low < scratch[0]);
+	for (int j = 1; j < size; j++)
+	{
+		low = MultiplyWords(m, modulus[j], &high);
+		low += carry;
+		high += (low < carry);
+		low += scratch[j];
+		high += (low < scratch[j]);
+		scratch[j - 1] = low;
+		carry = high;
+	}
+	scratch[size - 1] = scratch[size] + carry;
+	scratch[size] = scratch[size + 1] + (scratch[size - 1] < carry);
+	scratch[size + 1] = 0;
+}
+void MontgomeryMultiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2, const unsigned long long* modulus,
+	int size, unsigned long long inverse, unsigned long long* scratch)
+{
+	//Coarsely Integrated Operand Scanning (CIOS) Montgomery multiplication, scratch needs room for size + 2 words. For each word
+	//of num2 the row num1 * num2[i] is added to the running total and then a single MontgomeryStep() clears out the bottom word.
+	//The total never gets as big as 2n, so after all of the rows it's num1 * num2 * R^-1 mod n plus at most one extra n. Both
+	//numbers need to be less than the modulus. Every word of num1 and num2 is read before result is written so they can overlap.
+	for (int i = 0; i < size + 2; i++) scratch[i] = 0;
+
+	unsigned long long carry;
+	for (int i = 0; i < size; i++)
+	{
+		carry = MultiplyAddWords(scratch, num1, size, num2[i]);
+		scratch[size] += carry;
+		scratch[size + 1] = (scratch[size] < carry);
+		MontgomeryStep(scratch, modulus, size, inverse);
+	}
+
+	if (scratch[size] || CompareWords(scratch, modulus, size) >= 0) SubtractWords(scratch, modulus, size);
+	for (int i = 0; i < size; i++) result[i] = scratch[i];
+}
+void MontgomeryReduce(unsigned long long* result, const unsigned long long* num, const unsigned long long* modulus, int size, unsigned long long inverse,
+	unsigned long long* scratch)
+{
+	//the same as multiplying num by 1, all of the rows other than the first are 0 so only the steps are needed
+	for (int i = 0; i < size; i++) scratch[i] = num[i];
+	scratch[size] = scratch[size + 1] = 0;
+	for (int i = 0; i < size; i++) MontgomeryStep(scratch, modulus, size, inverse);
+
+	if (scratch[size] || CompareWords(scratch, modulus, size) >= 0) SubtractWords(scratch, modulus, size);
+	for (int i = 0; i < size; i++) result[i] = scratch[i];
+}
+void ModularAdd(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2, const unsigned long long* modulus, int size)
+{
+	//result = num1 + num2 mod modulus for two numbers that are already less than the modulus. Both words are read before the
+	//result word is written so result can be the same array as either number. This works the same in or out of Montgomery form.
+	unsigned long long carry = 0, sum;
+	for (int i = 0; i < size; i++)
+	{
+		sum = num1[i] + carry;
+		carry = (sum < carry);
+		sum += num2[i];
+		carry += (sum < num2[i]);
+		result[i] = sum;
+	}
+	if (carry || CompareWords(result, modulus, size) >= 0) SubtractWords(result, modulus, size);
+}
+void ModularSubtract(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2, const unsigned long long* modulus, int size)
+{
+	//result = num1 - num2 mod modulus, if the subtraction borrows then the modulus gets added back on
+	unsigned long long borrow = 0, difference, next_borrow;
+	for (int i = 0; i < size; i++)
+	{
+		difference = num1[i] - num2[i];
+		next_borrow = (difference > num1[i]);
+		next_borrow += (difference < borrow);
+		result[i] = difference - borrow;
+		borrow = next_borrow;
+	}
+	if (borrow) AddWords(result, modulus, size);
+}
+int PowmWindowBits(int exponent_bits)
+{
+	//a window of w bits costs 2^w multiplications to build the table and saves multiplications in proportion to exponent_bits / w,
+	//these are the lengths where each window size starts to win out over the one below it
+	if (exponent_bits <= 8) return 1;
+	if (exponent_bits <= 24) return 2;
+	if (exponent_bits <= 80) return 3;
+	if (exponent_bits <= 240) return 4;
+	if (exponent_bits <= 672) return 5;
+	if (exponent_bits <= 1792) return 6;
+	return 7;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <memory>
+
+//MODULAR ARITHMETIC
+//Reducing by the same modulus over and over again with %= means doing a full long division (plus the allocations that come with
+//creating temporary numbers) for every single multiplication. The contexts in this file do all of the expensive work that only
+//depends on the modulus once when they're created so that each reduction after that is just a few passes of multiply-adds over
+//fixed length word buffers.
+
+//The montgomery_context keeps numbers in Montgomery form, where a number a is stored as aR mod n with R = 2^(64 * size()). The
+//product of two numbers in this form can be reduced back into Montgomery form by adding a multiple of n that clears out the low
+//words and then dropping those words, there's no division anywhere. This only works when n is odd (n needs to have an inverse
+//mod 2^64).
+//
+//The word buffer functions all work on arrays of exactly size() words holding numbers that are already less than the modulus, and
+//none of them allocate once the MODULAR buffer of the thread's workspace has grown to size() + 2 words. The result is allowed to be
+//the same array as either of the inputs. Converting to and from int_64x types with to_montgomery() and from_montgomery() is where
+//any reducing of out of range numbers happens.
+class montgomery_context
+{
+public:
+	montgomery_context(const int_64x& modulus); //the modulus needs to be odd and greater than 1, this is asserted
+
+	bool valid() const; //false if the context was created with a modulus it can't use
+	int size() const; //the number of words in the modulus, and in every word buffer used by the context
+	const unsigned long long* modulus() const;
+	unsigned long long inverse() const; //-n^-1 mod 2^64
+
+	//WORD BUFFER FUNCTIONS
+	void to_montgomery(unsigned long long* result, const int_64x& num) const; //result = num * R mod n, num can be any int_64x
+	int_64x from_montgomery(const unsigned long long* num) const; //returns num * R^-1 mod n
+	void multiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2) const; //num1 * num2 * R^-1 mod n
+	void reduce(unsigned long long* result, const unsigned long long* num) const; //num * R^-1 mod n, i.e. converts out of Montgomery form
+	void one(unsigned long long* result) const; //R mod n, which is 1 in Montgomery form
+
+	//OTHER FUNCTIONS
+	int_64x mulmod(const int_64x& num1, const int_64x& num2) const; //num1 * num2 mod n in the range [0, n)
+
+private:
+	std::vector<unsigned long long> modulus_words;
+	std::vector<unsigned long long> r_mod; //R mod n
+	std::vector<unsigned long long> r_squared; //R^2 mod n, multiplying by this converts into Montgomery form
+	unsigned long long modulus_inverse;
+	int word_count;
+	int_64x modulus_value;
+};
+
+//The barrett_context works for any positive modulus, even or odd, and leaves numbers in their normal form. Dividing by n is replaced
+//with multiplying by a scaled reciprocal mu = floor(2^(128k) / n) (where k is the number of words in n) that's found once when the
+//context is created. The estimated quotient floor(x / 2^(64(k - 1))) * mu / 2^(64(k + 1)) is never more than a few short of the real
+//quotient, so after subtracting the estimated quotient times n only a couple of subtractions of n are left. Neither multiplication
+//needs all of its words: the quotient estimate only uses the top half of its product and the remainder only uses the bottom k + 1
+//words of its product, so both are truncated.
+//
+//The word buffer versions of reduce() and multiply() don't allocate once the MODULAR buffer of the thread's workspace has grown to
+//5 * size() + 4 words. reduce() takes numbers of 2 * size() words (i.e. any product of two numbers that are less than n).
+class barrett_context
+{
+public:
+	barrett_context(const int_64x& modulus); //the modulus needs to be greater than 0, this is asserted
+
+	bool valid() const; //false if the context was created with a modulus it can't use
+	int size() const; //the number of words in the modulus
+	const unsigned long long* modulus() const;
+
+	//WORD BUFFER FUNCTIONS
+	void reduce(unsigned long long* result, const unsigned long long* num) const; //result = num mod n, num has 2 * size() words
+	void multiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2) const; //num1 * num2 mod n
+
+	//OTHER FUNCTIONS
+	int_64x reduce(const int_64x& num) const; //num mod n in the range [0, n), num can be any int_64x
+	int_64x mulmod(const int_64x& num1, const int_64x& num2) const; //num1 * num2 mod n in the range [0, n)
+
+private:
+	void reduceWords(unsigned long long* result, const unsigned long long* num, unsigned long long* scratch) const;
+
+	std::vector<unsigned long long> modulus_words;
+	std::vector<unsigned long long> reciprocal; //mu, which has size() + 2 words (the lead word is only used when n is a power of 2^64)
+	int word_count;
+	int_64x modulus_value;
+};
+
+//A powm_table holds base^0, base^1, ... base^(2^window_bits - 1) mod n for a single base and modulus so that any number of
+//exponentiations of that base can share them. The powers are kept in Montgomery form when the modulus is odd and in their normal
+//form (reduced with a barrett_context) when it's even, and once the table has been built neither powm() nor powm_sec() divides.
+//
+//powm() is a left to right sliding window exponentiation: runs of 0 bits in the exponent only cost squarings and every window
+//starts and ends with a 1 bit, so only the odd powers in the table are ever used. powm_sec() is the fixed window version meant for
+//secret exponents. It always does window_bits squarings and one multiplication for every window_bits bits of the exponent (all of
+//the words in exponent.digits are used, not just the significant ones) and it reads every entry of the table for each window so the
+//memory access pattern doesn't depend on the exponent. The final subtraction inside of the reduction kernels is still a branch, so
+//this hides the exponent from timing of the window pattern and the cache, not from every possible side channel.
+class powm_table
+{
+public:
+	powm_table(const int_64x& base, const int_64x& modulus, int window_bits = 5); //the modulus needs to be greater than 0, this is asserted
+
+	bool valid() const;
+	int window() const;
+	int_64x powm(const int_64x& exponent) const; //base^exponent mod n, the exponent can't be negative (0 is returned if it is)
+	int_64x powm_sec(const int_64x& exponent) const;
+
+private:
+	void multiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2) const;
+	int_64x toInt64x(const unsigned long long* num) const;
+
+	std::unique_ptr<montgomery_context> montgomery; //only one of these is ever used
+	std::unique_ptr<barrett_context> barrett;
+	std::vector<unsigned long long> powers; //entry i is at powers[i * word_count]
+	int window_bits;
+	int word_count;
+};
+
+//Related Functions
+void ReduceModulus(unsigned long long* result, const int_64x& num, const int_64x& modulus, int size); //result = num mod modulus in "size" words
+unsigned long long NegativeInverseWord(unsigned long long num); //-num^-1 mod 2^64 for odd num
+void MontgomeryMultiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2, const unsigned long long* modulus,
+	int size, unsigned long long inverse, unsigned long long* scratch);
+void MontgomeryReduce(unsigned long long* result, const unsigned long long* num, const unsigned long long* modulus, int size, unsigned long long inverse,
+	unsigned long long* scratch);
+void MontgomeryStep(unsigned long long* scratch, const unsigned long long* modulus, int size, unsigned long long inverse);
+void ModularAdd(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2, const unsigned long long* modulus, int size);
+void ModularSubtract(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2, const unsigned long long* modulus, int size);
+int PowmWindowBits(int exponent_bits); //the window size that needs the fewest multiplications for an exponent this long
+
+//Exponentiation Functions
+//base^exponent mod modulus in the range [0, modulus). These build a powm_table for a single use, when the same base is going to be
+//raised to a lot of different exponents it's faster to build the table once and call its functions instead.
+int_64x powm(const int_64x& base, const int_64x& exponent, const int_64x& modulus);
+int_64x powm_sec(const int_64x& base, const int_64x& exponent, const int_64x& modulus);
@@ -0,0 +1,959 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_number_theory.h>
+#include <utility>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <memory>
+
+//GCD HELPERS
+unsigned long long BinaryGCD(unsigned long long num1, unsigned long long num2)
+{
+	//Stein's algorithm, any common factors of 2 are pulled out first and after that the smaller number is repeatedly subtracted
+	//from the larger one (which leaves an even number, so its 2's can be shifted away)
+	if (!num1) return num2;
+	if (!num2) return num1;
+
+	int shift = CountTrailingZeros(num1 | num2);
+	num1 >>= CountTrailingZeros(num1);
+	do
+	{
+		num2 >>= CountTrailingZeros(num2);
+		if (num1 > num2) std::swap(num1, num2);
+		num2 -= num1;
+	} while (num2);
+	return num1 << shift;
+}
+
+#if defined(INT_64X_NATIVE_128)
+unsigned __int128 BinaryGCD128(unsigned __int128 num1, unsigned __int128 num2)
+{
+	//the same as BinaryGCD() for two word numbers, it drops down to single words as soon as both numbers fit
+	auto trailing_zeros = [](unsigned __int128 value)
+	{
+		unsigned long long low = (unsigned long long)value;
+		return low ? CountTrailingZeros(low) : 64 + CountTrailingZeros((unsigned long long)(value >> 64));
+	};
+	if (!num1) return num2;
+	if (!num2) return num1;
+
+	int shift = trailing_zeros(num1 | num2);
+	num1 >>= trailing_zeros(num1);
+	do
+	{
+		num2 >>= trailing_zeros(num2);
+		if (num1 > num2) std::swap(num1, num2);
+		if (!(num2 >> 64)) return (unsigned __int128)BinaryGCD((unsigned long long)num1, (unsigned long long)num2) << shift;
+		num2 -= num1;
+	} while (num2);
+	return num1 << shift;
+}
+unsigned __int128 NativeMagnitude(__int128 value)
+{
+	//the magnitude of -2^127 doesn't fit into a signed 128-bit integer so the negation has to be done unsigned
+	return (value < 0) ? (unsigned __int128)0 - (unsigned __int128)value : (unsigned __int128)value;
+}
+#endif
+
+unsigned long long BitsAt(const unsigned long long* num, int size, int shift)
+{
+	//returns the 64 bits of num starting at bit "shift", any word past the end of num is treated as 0
+	int word = shift / 64, offset = shift % 64;
+	unsigned long long bits = (word < size) ? (num[word] >> offset) : 0;
+	if (offset && word + 1 < size) bits |= num[word + 1] << (64 - offset);
+	return bits;
+}
+unsigned long long LeadingBits(const unsigned long long* num, int size, int shift)
+{
+	//the 62 bits of num starting at bit "shift", which leaves room for Lehmer's cofactors to be added without overflowing
+	return BitsAt(num, size, shift) & 0x3FFFFFFFFFFFFFFF;
+}
+int TrimMagnitude(const unsigned long long* num, int size)
+{
+	//the number of words left after removing lead words of 0, a value of 0 has a size of 0 here
+	while (size > 0 && num[size - 1] == 0) size--;
+	return size;
+}
+void ApplyCofactors(unsigned long long* result, const unsigned long long* x, int x_size, long long a, const unsigned long long* y, int y_size, long long b)
+{
+	//result = a * x + b * y where the answer is known to be positive. At most one of the Lehmer cofactors on a row is negative, so
+	//the term with the cofactor that isn't negative is written into result first and then the other term is added or subtracted.
+	//result needs x_size + 1 words.
+	const unsigned long long* first = x, *second = y;
+	int first_size = x_size, second_size = y_size;
+	long long first_factor = a, second_factor = b;
+	if (a < 0)
+	{
+		first = y;
+		second = x;
+		first_size = y_size;
+		second_size = x_size;
+		first_factor = b;
+		second_factor = a;
+	}
+
+	for (int i = first_size + 1; i <= x_size; i++) result[i] = 0;
+	result[first_size] = MultiplyWordsBySingle(result, first, first_size, first_factor);
+	if (second_factor > 0) AddWordAt(result, x_size + 1, second_size, MultiplyAddWords(result, second, second_size, second_factor));
+	else if (second_factor < 0) SubtractWordAt(result, x_size + 1, second_size, MultiplySubtractWords(result, second, second_size, 0 - (unsigned long long)second_factor));
+}
+void AddCofactor(int_64x& result, const int_64x& num, long long factor)
+{
+	//result += factor * num for a signed single word factor
+	if (factor >= 0) addmul_1(result, num, factor);
+	else submul_1(result, num, 0 - (unsigned long long)factor);
+}
+
+//The GCD engine used by gcd() and gcdext(). x and y hold the magnitudes of the two numbers (x >= y) and get overwritten, when it's
+//done x points at the gcd. x, y and both spares need room for n + 1 words and scratch needs 3n + 2 words, where n is the starting
+//size of x. The cofactors are only tracked when s_x and s_y aren't
+//null, they follow the rule (x = s_x * num1 mod num2) and (y = s_y * num1 mod num2) for the original numbers.
+void LehmerGCD(unsigned long long*& x, int& x_size, unsigned long long*& y, int& y_size, unsigned long long* spare, unsigned long long* spare2,
+	unsigned long long* scratch, int_64x* s_x, int_64x* s_y)
+{
+	while (y_size)
+	{
+		//both numbers fit into a single word, so unless the cofactors are needed binary GCD can finish the job
+		if (x_size == 1 && !s_x)
+		{
+			x[0] = BinaryGCD(x[0], y[0]);
+			return;
+		}
+
+		//run Euclid's algorithm on the leading bits (Knuth's Algorithm L), which stops as soon as the quotient for the leading
+		//bits could be different than the quotient for the full numbers. The cofactors never get bigger than the leading bits.
+		int x_bits = 64 * (x_size - 1) + 64 - CountLeadingZeros(x[x_size - 1]);
+		int shift = (x_bits > 62) ? x_bits - 62 : 0;
+		long long x_hat = LeadingBits(x, x_size, shift), y_hat = LeadingBits(y, y_size, shift);
+		long long a = 1, b = 0, c = 0, d = 1, q, temp;
+		while (y_hat + c != 0 && y_hat + d != 0)
+		{
+			q = (x_hat + a) / (y_hat + c);
+			if (q != (x_hat + b) / (y_hat + d)) break;
+			temp = a - q * c; a = c; c = temp;
+			temp = b - q * d; b = d; d = temp;
+			temp = x_hat - q * y_hat; x_hat = y_hat; y_hat = temp;
+		}
+
+		if (b == 0)
+		{
+			//no progress from the leading bits, so do one full division step: (x, y) = (y, x mod y)
+			unsigned long long* quotient = scratch;
+			unsigned long long* division_scratch = scratch + x_size + 1;
+			if (y_size == 1)
+			{
+				spare[0] = DivideWordsBySingle(quotient, x, x_size, y[0]);
+				for (int i = 1; i < x_size; i++) spare[i] = 0;
+			}
+			else DivideWords(quotient, spare, x, x_size, y, y_size, division_scratch);
+
+			if (s_x)
+			{
+				//(s_x, s_y) = (s_y, s_x - q * s_y)
+				int quotient_size = x_size - y_size + 1;
+				int_64x quotient_value;
+				StoreMagnitude(quotient_value.digits, quotient, quotient_size, false);
+				submul(*s_x, quotient_value, *s_y);
+				s_x->digits.swap(s_y->digits);
+			}
+
+			unsigned long long* old_x = x;
+			x = y;
+			x_size = y_size;
+			y = spare;
+			y_size = TrimMagnitude(spare, y_size);
+			spare = old_x;
+			continue;
+		}
+
+		//apply all of the steps at once: (x, y) = (a * x + b * y, c * x + d * y)
+		ApplyCofactors(spare, x, x_size, a, y, y_size, b);
+		ApplyCofactors(spare2, x, x_size, c, y, y_size, d);
+		if (s_x)
+		{
+			int_64x new_s_x = 0, new_s_y = 0;
+			AddCofactor(new_s_x, *s_x, a);
+			AddCofactor(new_s_x, *s_y, b);
+			AddCofactor(new_s_y, *s_x, c);
+			AddCofactor(new_s_y, *s_y, d);
+			*s_x = new_s_x;
+			*s_y = new_s_y;
+		}
+
+		std::swap(x, spare);
+		std::swap(y, spare2);
+		x_size = TrimMagnitude(x, x_size + 1);
+		y_size = TrimMagnitude(y, x_size);
+	}
+}
+
+//GCD FUNCTIONS
+int_64x gcd(const int_64x& num1, const int_64x& num2)
+{
+	if (num1.digits.empty() || num2.digits.empty()) return abs(num1.digits.empty() ? num2 : num1);
+
+#if defined(INT_64X_NATIVE_128)
+	//the most common case (i.e. normalizing fractions) is numbers that are small enough to skip all of the buffers
+	__int128 num1_value, num2_value;
+	if (LoadNative(num1.digits, num1_value) && LoadNative(num2.digits, num2_value))
+	{
+		unsigned __int128 answer = BinaryGCD128(NativeMagnitude(num1_value), NativeMagnitude(num2_value));
+		unsigned long long words[2] = { (unsigned long long)answer, (unsigned long long)(answer >> 64) };
+		int_64x result;
+		StoreMagnitude(result.digits, words, 2, false);
+		return result;
+	}
+#endif
+
+	//every buffer the engine needs comes out of a single block: x, y and two spares of n + 1 words, plus the quotient and the
+	//scratch space for DivideWords()
+	int n = (num1.digits.size() > num2.digits.size()) ? num1.digits.size() : num2.digits.size();
+	std::vector<unsigned long long> block(8 * n + 8, 0);
+	unsigned long long* x = block.data(), *y = x + n + 1, *spare = y + n + 1, *spare2 = spare + n + 1, *scratch = spare2 + n + 1;
+	int x_size = TrimMagnitude(x, CopyMagnitude(num1.digits, x));
+	int y_size = TrimMagnitude(y, CopyMagnitude(num2.digits, y));
+	if (x_size < y_size || (x_size == y_size && CompareWords(x, y, x_size) < 0))
+	{
+		std::swap(x, y);
+		std::swap(x_size, y_size);
+	}
+
+	LehmerGCD(x, x_size, y, y_size, spare, spare2, scratch, nullptr, nullptr);
+
+	int_64x result;
+	StoreMagnitude(result.digits, x, x_size ? x_size : 1, false);
+	return result;
+}
+int_64x lcm(const int_64x& num1, const int_64x& num2)
+{
+	int_64x divisor = gcd(num1, num2);
+	if (divisor == 0) return 0;
+	return abs((num1 / divisor) * num2);
+}
+int_64x gcdext(int_64x& s, int_64x& t, const int_64x& num1, const int_64x& num2)
+{
+	if (num1.digits.empty() || num2.digits.empty())
+	{
+		s = 0;
+		t = 0;
+		return 0;
+	}
+
+	int n = (num1.digits.size() > num2.digits.size()) ? num1.digits.size() : num2.digits.size();
+	std::vector<unsigned long long> block(8 * n + 8, 0);
+	unsigned long long* x = block.data(), *y = x + n + 1, *spare = y + n + 1, *spare2 = spare + n + 1, *scratch = spare2 + n + 1;
+	int x_size = TrimMagnitude(x, CopyMagnitude(num1.digits, x));
+	int y_size = TrimMagnitude(y, CopyMagnitude(num2.digits, y));
+
+	//the cofactors are for |num1|, x starts out as |num1| = 1 * |num1| and y as |num2| = 0 * |num1| (mod |num2|)
+	int_64x s_x = 1, s_y = 0;
+	if (x_size < y_size || (x_size == y_size && CompareWords(x, y, x_size) < 0))
+	{
+		std::swap(x, y);
+		std::swap(x_size, y_size);
+		std::swap(s_x, s_y);
+	}
+
+	LehmerGCD(x, x_size, y, y_size, spare, spare2, scratch, &s_x, &s_y);
+
+	int_64x g;
+	StoreMagnitude(g.digits, x, x_size ? x_size : 1, false);
+
+	//s_x works for |num1| so it flips along with num1, and then t is whatever's left over (which divides exactly)
+	s = (num1.digits.back() >> 63) ? 0 - s_x : s_x;
+	if (num2 == 0) t = 0;
+	else t = (g - s * num1) / num2;
+	return g;
+}
+bool invert(int_64x& result, const int_64x& num, const int_64x& modulus)
+{
+	//num * s + modulus * t = 1 means that s is the inverse of num mod modulus
+	int_64x s, t;
+	int_64x g = gcdext(s, t, num, modulus);
+	if (!(g == 1) || modulus == 0)
+	{
+		result = 0;
+		return false;
+	}
+
+	result = s % modulus;
+	if (result.digits.back() >> 63) result += abs(modulus);
+	return true;
+}
+
+//BATCH INVERSION
+//The numbers are kept in Montgomery form for an odd modulus and in their normal form (with Barrett reduction) otherwise, this
+//just hides which one is being used
+struct BatchModulus
+{
+	std::unique_ptr<montgomery_context> montgomery;
+	std::unique_ptr<barrett_context> barrett;
+	int_64x modulus;
+	int size;
+
+	BatchModulus(const int_64x& modulus) : modulus(modulus)
+	{
+		if (modulus.digits[0] & 1)
+		{
+			montgomery.reset(new montgomery_context(modulus));
+			size = montgomery->size();
+		}
+		else
+		{
+			barrett.reset(new barrett_context(modulus));
+			size = barrett->size();
+		}
+	}
+	void load(unsigned long long* result, const int_64x& num) const
+	{
+		if (montgomery) montgomery->to_montgomery(result, num);
+		else ReduceModulus(result, num, modulus, size);
+	}
+	int_64x store(const unsigned long long* num) const
+	{
+		if (montgomery) return montgomery->from_montgomery(num);
+
+		int_64x answer;
+		answer.digits.assign(size + 1, 0);
+		for (int i = 0; i < size; i++) answer.digits[i] = num[i];
+		RemoveRedundantWords(answer.digits);
+		return answer;
+	}
+	void multiply(unsigned long long* result, const unsigned long long* num1, const unsigned long long* num2) const
+	{
+		if (montgomery) montgomery->multiply(result, num1, num2);
+		else barrett->multiply(result, num1, num2);
+	}
+};
+
+void BatchInvertGroup(const BatchModulus& arithmetic, const std::vector<int>& group, unsigned long long* values, unsigned long long* prefix,
+	int_64x* nums, std::vector<bool>& inverted)
+{
+	//values holds every number of the batch (size words each) and prefix has room for the running products of the whole batch, the
+	//entries for the numbers in "group" are the only ones that get used here
+	int size = arithmetic.size, count = group.size();
+	unsigned long long* inverse = prefix + (group.back()) * size; //the last running product isn't needed again once it's inverted
+
+	for (int i = 0; i < size; i++) prefix[group[0] * size + i] = values[group[0] * size + i];
+	for (int i = 1; i < count; i++) arithmetic.multiply(prefix + group[i] * size, prefix + group[i - 1] * size, values + group[i] * size);
+
+	int_64x total_inverse;
+	if (!invert(total_inverse, arithmetic.store(prefix + group.back() * size), arithmetic.modulus))
+	{
+		//at least one of the numbers shares a factor with the modulus, split the group in half until they've been found
+		if (count == 1)
+		{
+			nums[group[0]] = 0;
+			inverted[group[0]] = false;
+			return;
+		}
+		std::vector<int> low(group.begin(), group.begin() + count / 2), high(group.begin() + count / 2, group.end());
+		BatchInvertGroup(arithmetic, low, values, prefix, nums, inverted);
+		BatchInvertGroup(arithmetic, high, values, prefix, nums, inverted);
+		return;
+	}
+
+	//inverse = (a1 * ... * ai)^-1, so multiplying by the running product up to a(i-1) leaves ai^-1 and multiplying by ai leaves
+	//the inverse of the running product one step down
+	arithmetic.load(inverse, total_inverse);
+	for (int i = count - 1; i > 0; i--)
+	{
+		unsigned long long* previous = prefix + group[i - 1] * size;
+		arithmetic.multiply(previous, inverse, previous); //ai^-1, written over the running product that isn't needed anymore
+		arithmetic.multiply(inverse, inverse, values + group[i] * size);
+		nums[group[i]] = arithmetic.store(previous);
+		for (int j = 0; j < size; j++) previous[j] = inverse[j];
+		inverse = previous;
+	}
+	nums[group[0]] = arithmetic.store(inverse);
+}
+
+std::vector<bool> batch_invert(int_64x* nums, int count, const int_64x& modulus)
+{
+	std::vector<bool> inverted(count, false);
+	if (modulus.digits.empty() || (modulus.digits.back() >> 63) || modulus == 0) return inverted;
+	if (modulus == 1)
+	{
+		//everything is 0 mod 1, which invert() treats as its own inverse
+		for (int i = 0; i < count; i++)
+		{
+			nums[i] = 0;
+			inverted[i] = true;
+		}
+		return inverted;
+	}
+
+	//numbers that are 0 mod the modulus would wipe out the whole running product so they're taken out right away
+	BatchModulus arithmetic(modulus);
+	int size = arithmetic.size;
+	std::vector<unsigned long long> values(count * size), prefix(count * size);
+	std::vector<int> group;
+	for (int i = 0; i < count; i++)
+	{
+		arithmetic.load(values.data() + i * size, nums[i]);
+		bool zero = true;
+		for (int j = 0; j < size && zero; j++) zero = !values[i * size + j];
+		inverted[i] = !zero;
+		if (zero) nums[i] = 0;
+		else group.push_back(i);
+	}
+
+	if (!group.empty()) BatchInvertGroup(arithmetic, group, values.data(), prefix.data(), nums, inverted);
+	return inverted;
+}
+std::vector<bool> batch_invert(std::vector<int_64x>& nums, const int_64x& modulus)
+{
+	return batch_invert(nums.data(), nums.size(), modulus);
+}
+
+//ROOT HELPERS
+int_64x RootEstimate(const int_64x& num, int k)
+{
+	//Returns a number that's slightly larger than num^(1/k) for a positive num, good to about 40 bits. The top 64 bits of num (found
+	//from its lead bit location) give num < (top + 1) * 2^shift, so the root is less than 2^(shift / k) * (top + 1)^(1/k). Splitting
+	//shift into quotient * k + remainder keeps the part that goes through the floating point functions small, so the rounding error
+	//doesn't grow with the size of num. The estimate gets pushed up a little more than that rounding error could ever be.
+	int bits = num.bit_length();
+	int shift = (bits > 64) ? bits - 64 : 0;
+	unsigned long long top = BitsAt(num.digits.data(), num.digits.size(), shift);
+
+	double fraction = (shift % k + std::log2((double)top + 1.0)) / k;
+	int exponent = shift / k + (int)fraction;
+	unsigned long long mantissa = (unsigned long long)(std::exp2(fraction - (int)fraction + 52) * (1.0 + 1.0 / (1ULL << 40))) + 1;
+
+	//the root is mantissa * 2^(exponent - 52)
+	if (exponent >= 52) return int_64x(mantissa, exponent - 52);
+	return int_64x((mantissa >> (52 - exponent)) + 1);
+}
+int_64x RootNewton(const int_64x& num, int k)
+{
+	//Newton's method for floor(num^(1/k)) on a positive num, x = ((k - 1) * x + num / x^(k - 1)) / k. Starting from above the root
+	//every step stays above it (or lands on it) and goes down, so as soon as a step fails to go down x is the answer. With 40 good
+	//bits from RootEstimate() this is usually only 2 or 3 divisions for numbers a few thousand bits long.
+	int_64x x = RootEstimate(num, k), next;
+	int_64x k_minus_one = k - 1;
+	while (true)
+	{
+		if (k == 2) next = (x + num / x) >> 1;
+		else next = (x * k_minus_one + num / pow(x, k - 1)) / k;
+		if (!(next < x)) return x;
+		x = next;
+	}
+}
+bool ResidueFiltersPass(const int_64x& num)
+{
+	//Cheap tests that throw out most numbers that can't be squares. Squares can only land on 12 of the 64 possible values mod 64,
+	//which only needs the bottom word. After that a single pass of DivideWordsBySingle() finds num mod 63 * 65 * 11, which gets
+	//checked against the squares mod 63, 65 and 11. Together these throw out over 99% of non-squares.
+	struct SquareTables
+	{
+		bool mod64[64], mod63[63], mod65[65], mod11[11];
+		SquareTables()
+		{
+			for (int i = 0; i < 64; i++) mod64[i] = mod63[i % 63] = false;
+			for (int i = 0; i < 65; i++) mod65[i] = false;
+			for (int i = 0; i < 11; i++) mod11[i] = false;
+			for (int i = 0; i < 65; i++)
+			{
+				mod64[(i * i) % 64] = true;
+				mod63[(i * i) % 63] = true;
+				mod65[(i * i) % 65] = true;
+				mod11[(i * i) % 11] = true;
+			}
+		}
+	};
+	static const SquareTables tables;
+
+	if (!tables.mod64[num.digits[0] % 64]) return false;
+
+	unsigned long long quotient_space[16];
+	std::vector<unsigned long long> quotient_heap;
+	unsigned long long* quotient = quotient_space;
+	if (num.digits.size() > 16)
+	{
+		quotient_heap.resize(num.digits.size());
+		quotient = quotient_heap.data();
+	}
+	unsigned long long residue = DivideWordsBySingle(quotient, num.digits.data(), num.digits.size(), 63 * 65 * 11);
+	return tables.mod63[residue % 63] && tables.mod65[residue % 65] && tables.mod11[residue % 11];
+}
+
+//ROOT FUNCTIONS
+int_64x isqrt(const int_64x& num)
+{
+	if (num.digits.empty() || num == 0) return 0;
+	if (num.digits.back() >> 63) return 0;
+	return RootNewton(num, 2);
+}
+int_64x iroot(const int_64x& num, int k)
+{
+	//odd roots of negative numbers are rounded towards 0, the same way that division is
+	if (k < 1) return 0;
+	if (num.digits.empty() || num == 0) return 0;
+	if (k == 1) return num;
+
+	if (num.digits.back() >> 63)
+	{
+		if (!(k & 1)) return 0;
+		return 0 - RootNewton(abs(num), k);
+	}
+	return RootNewton(num, k);
+}
+bool is_square(const int_64x& num)
+{
+	if (num.digits.empty() || (num.digits.back() >> 63)) return false;
+	if (!ResidueFiltersPass(num)) return false;
+
+	int_64x root = isqrt(num);
+	return root * root == num;
+}
+bool is_perfect_power(const int_64x& num)
+{
+	//returns true if num = x^k for some integer x and some k >= 2 (0, 1 and -1 all count). If num = x^k then num is also a p'th
+	//power for every prime p that divides k, so only prime k's need to be checked. On top of that the power of 2 in num has to be
+	//a multiple of k, and a negative number can only be an odd power.
+	if (num.digits.empty()) return false;
+	bool negative = num.digits.back() >> 63;
+	int_64x magnitude = abs(num);
+	if (magnitude == 0 || magnitude == 1) return true;
+
+	int twos = magnitude.count_trailing_zeros(), bits = magnitude.bit_length();
+
+	for (int k = 2; k <= bits; k++)
+	{
+		bool prime = true;
+		for (int d = 2; d * d <= k && prime; d++) prime = (k % d);
+		if (!prime || (negative && k == 2) || (twos && twos % k)) continue;
+		if (k == 2 && !ResidueFiltersPass(magnitude)) continue;
+
+		int_64x root = RootNewton(magnitude, k);
+		if (pow(root, k) == magnitude) return true;
+	}
+	return false;
+}
+
+//PRIMALITY HELPERS
+struct SmallPrimeGroups
+{
+	//the odd primes below 1000 split into groups that each have a product that fits into a single word
+	std::vector<unsigned long long> primes;
+	std::vector<unsigned long long> products;
+	std::vector<int> group_starts; //group i is primes[group_starts[i]] up to (but not including) primes[group_starts[i + 1]]
+
+	SmallPrimeGroups()
+	{
+		std::vector<bool> composite(1000, false);
+		for (int i = 3; i < 1000; i += 2)
+		{
+			if (composite[i]) continue;
+			primes.push_back(i);
+			for (int j = i * i; j < 1000; j += 2 * i) composite[j] = true;
+		}
+
+		unsigned long long product = 1;
+		for (int i = 0; i < primes.size(); i++)
+		{
+			if (product > 0xFFFFFFFFFFFFFFFF / primes[i] || i == 0)
+			{
+				if (i) products.push_back(product);
+				group_starts.push_back(i);
+				product = 1;
+			}
+			product *= primes[i];
+		}
+		products.push_back(product);
+		group_starts.push_back(primes.size());
+	}
+};
+const SmallPrimeGroups& SmallPrimes()
+{
+	static const SmallPrimeGroups groups;
+	return groups;
+}
+
+int TrialDivision(const int_64x& num)
+{
+	const SmallPrimeGroups& groups = SmallPrimes();
+	int size = num.digits.size();
+	unsigned long long quotient_space[16];
+	std::vector<unsigned long long> quotient_heap;
+	unsigned long long* quotient = quotient_space;
+	if (size > 16)
+	{
+		quotient_heap.resize(size);
+		quotient = quotient_heap.data();
+	}
+
+	//num only needs to be checked against a prime directly when it's small enough to be that prime
+	bool single_word = (SignificantWords(num.digits) == 1);
+	if (!(num.digits[0] & 1)) return (single_word && num.digits[0] == 2) ? 1 : -1;
+	for (int group = 0; group < groups.products.size(); group++)
+	{
+		unsigned long long remainder = DivideWordsBySingle(quotient, num.digits.data(), size, groups.products[group]);
+		for (int i = groups.group_starts[group]; i < groups.group_starts[group + 1]; i++)
+		{
+			if (remainder % groups.primes[i]) continue;
+			return (single_word && num.digits[0] == groups.primes[i]) ? 1 : -1;
+		}
+	}
+	return 0;
+}
+int JacobiSymbol(long long num, const int_64x& n)
+{
+	//Pull the sign and the factors of 2 out of num, then flip the symbol with quadratic reciprocity so that the rest of the work
+	//is on single words: (a / n) = (n / a) * (-1)^((a - 1) / 2 * (n - 1) / 2) for odd a, and n mod a only needs one pass over n.
+	unsigned long long n_low = n.digits[0]; //only the bottom few bits of n matter for the sign flips
+	int result = 1;
+	unsigned long long a = (num < 0) ? 0 - (unsigned long long)num : num;
+	if (num < 0 && (n_low & 3) == 3) result = -result;
+	if (!a) return (SignificantWords(n.digits) == 1 && n_low == 1) ? 1 : 0;
+
+	while (!(a & 1))
+	{
+		a >>= 1;
+		if ((n_low & 7) == 3 || (n_low & 7) == 5) result = -result;
+	}
+	if (a == 1) return result;
+	if ((a & 3) == 3 && (n_low & 3) == 3) result = -result;
+
+	std::vector<unsigned long long> quotient(n.digits.size());
+	unsigned long long b = DivideWordsBySingle(quotient.data(), n.digits.data(), n.digits.size(), a);
+
+	//(b / a) with both numbers in single words
+	while (b)
+	{
+		while (!(b & 1))
+		{
+			b >>= 1;
+			if ((a & 7) == 3 || (a & 7) == 5) result = -result;
+		}
+		std::swap(a, b);
+		if ((a & 3) == 3 && (b & 3) == 3) result = -result;
+		b %= a;
+	}
+	return (a == 1) ? result : 0;
+}
+
+bool MillerRabin(const montgomery_context& context, const int_64x& base, const int_64x& odd_part, int twos, unsigned long long* buffers)
+{
+	//Strong Fermat test to the given base where n - 1 = odd_part * 2^twos. buffers needs room for 4 * size words. The powers of
+	//the base are found with left to right binary exponentiation, and when the base is 2 the multiplication by the base is just a
+	//modular doubling.
+	int size = context.size();
+	unsigned long long* x = buffers, *base_words = x + size, *one = base_words + size, *minus_one = one + size;
+	context.one(one);
+	for (int i = 0; i < size; i++) minus_one[i] = 0;
+	ModularSubtract(minus_one, minus_one, one, context.modulus(), size);
+	context.to_montgomery(base_words, base);
+	bool base_two = (base == 2);
+
+	for (int i = 0; i < size; i++) x[i] = one[i];
+	for (int bit = odd_part.bit_length() - 1; bit >= 0; bit--)
+	{
+		context.multiply(x, x, x);
+		if (!odd_part.test_bit(bit)) continue;
+		if (base_two) ModularAdd(x, x, x, context.modulus(), size);
+		else context.multiply(x, x, base_words);
+	}
+
+	if (!CompareWords(x, one, size) || !CompareWords(x, minus_one, size)) return true;
+	for (int r = 1; r < twos; r++)
+	{
+		context.multiply(x, x, x);
+		if (!CompareWords(x, minus_one, size)) return true;
+		if (!CompareWords(x, one, size)) return false;
+	}
+	return false;
+}
+bool StrongLucas(const montgomery_context& context, const int_64x& n, unsigned long long* buffers)
+{
+	//Strong Lucas probable prime test with Selfridge's parameters: D is the first of 5, -7, 9, -11, ... with (D / n) = -1, P = 1
+	//and Q = (1 - D) / 4. With n + 1 = d * 2^s, n passes if U_d = 0 or V_(d * 2^r) = 0 for some r < s. Only V and Q^k are carried
+	//along, U_d = 0 is checked with 2 * V_(d + 1) = P * V_d which is the same thing since D has an inverse mod n. buffers needs room
+	//for 6 * size words.
+	long long d_value = 5;
+	for (int tries = 0;; tries++)
+	{
+		int jacobi = JacobiSymbol(d_value, n);
+		if (jacobi == -1) break;
+		if (jacobi == 0 && !(n == (d_value < 0 ? -d_value : d_value))) return false;
+
+		//a square never gives -1 so there's no point looking for D forever
+		if (tries == 10 && is_square(n)) return false;
+		d_value = (d_value > 0) ? -(d_value + 2) : -d_value + 2;
+	}
+
+	int size = context.size();
+	const unsigned long long* modulus = context.modulus();
+	unsigned long long* v = buffers, *v_next = v + size, *q_power = v_next + size, *q = q_power + size, *q_next = q + size, *temp = q_next + size;
+	context.to_montgomery(q, int_64x((1 - d_value) / 4));
+	context.one(q_power);
+	ModularAdd(v, q_power, q_power, modulus, size); //V_0 = 2
+	context.one(v_next); //V_1 = P = 1
+
+	int_64x n_plus_one = n + 1;
+	int twos = n_plus_one.count_trailing_zeros();
+	int_64x odd_part = n_plus_one >> twos;
+
+	//Walk (V_k, V_k+1, Q^k) up to k = d one bit at a time. A 0 bit takes k to 2k and a 1 bit takes k to 2k + 1 using
+	//V_2k = V_k^2 - 2Q^k and V_2k+1 = V_k * V_k+1 - P * Q^k.
+	for (int bit = odd_part.bit_length() - 1; bit >= 0; bit--)
+	{
+		context.multiply(temp, v, v_next);
+		ModularSubtract(temp, temp, q_power, modulus, size); //V_2k+1
+		if (odd_part.test_bit(bit))
+		{
+			context.multiply(q_next, q_power, q); //Q^k+1
+			context.multiply(v_next, v_next, v_next);
+			ModularSubtract(v_next, v_next, q_next, modulus, size);
+			ModularSubtract(v_next, v_next, q_next, modulus, size); //V_2k+2
+			for (int i = 0; i < size; i++) v[i] = temp[i];
+			context.multiply(q_power, q_power, q_next); //Q^2k+1
+		}
+		else
+		{
+			context.multiply(v, v, v);
+			ModularSubtract(v, v, q_power, modulus, size);
+			ModularSubtract(v, v, q_power, modulus, size); //V_2k
+			for (int i = 0; i < size; i++) v_next[i] = temp[i];
+			context.multiply(q_power, q_power, q_power); //Q^2k
+		}
+	}
+
+	ModularAdd(temp, v_next, v_next, modulus, size);
+	if (!CompareWords(temp, v, size)) return true; //U_d = 0
+	for (int r = 0; r < twos; r++)
+	{
+		bool zero = true;
+		for (int i = 0; i < size && zero; i++) zero = !v[i];
+		if (zero) return true; //V_(d * 2^r) = 0
+		if (r == twos - 1) break;
+
+		context.multiply(v, v, v);
+		ModularSubtract(v, v, q_power, modulus, size);
+		ModularSubtract(v, v, q_power, modulus, size);
+		context.multiply(q_power, q_power, q_power);
+	}
+	return false;
+}
+
+//PRIMALITY FUNCTIONS
+bool is_probable_prime(const int_64x& num, int extra_rounds)
+{
+	if (num.digits.empty() || (num.digits.back() >> 63) || num < 2) return false;
+
+	int trial = TrialDivision(num);
+	if (trial) return trial > 0;
+	if (num < 1000 * 1000) return true; //anything this small without a factor below 1000 is prime
+
+	montgomery_context context(num);
+	std::vector<unsigned long long> buffers(6 * context.size());
+	int_64x n_minus_one = num - 1;
+	int twos = n_minus_one.count_trailing_zeros();
+	int_64x odd_part = n_minus_one >> twos;
+
+	if (!MillerRabin(context, 2, odd_part, twos, buffers.data())) return false;
+	if (!StrongLucas(context, num, buffers.data())) return false;
+
+	const SmallPrimeGroups& groups = SmallPrimes();
+	for (int i = 0; i < extra_rounds && i < groups.primes.size(); i++)
+	{
+		if (!MillerRabin(context, groups.primes[i], odd_part, twos, buffers.data())) return false;
+	}
+	return true;
+}
+std::vector<bool> is_probable_prime(const std::vector<int_64x>& candidates, int extra_rounds, int threads)
+{
+	//the answers are written as chars since different threads can't safely write to neighboring bits of a std::vector<bool>
+	int count = candidates.size();
+	std::vector<char> answers(count, 0);
+	if (threads <= 0) threads = std::thread::hardware_concurrency();
+	if (threads > count) threads = count;
+	if (threads < 1) threads = 1;
+
+	std::atomic<int> next_candidate(0);
+	auto worker = [&]()
+	{
+		for (int i = next_candidate++; i < count; i = next_candidate++) answers[i] = is_probable_prime(candidates[i], extra_rounds);
+	};
+
+	std::vector<std::thread> workers;
+	for (int i = 1; i < threads; i++) workers.emplace_back(worker);
+	worker();
+	for (int i = 0; i < workers.size(); i++) workers[i].join();
+
+	return std::vector<bool>(answers.begin(), answers.end());
+}
+
+//PRODUCT HELPERS
+const int PRODUCT_TREE_LEAF = 8; //ranges with this many factors or fewer are just multiplied together one after the other
+
+void TrimProduct(std::vector<unsigned long long>& product)
+{
+	while (product.size() > 1 && product.back() == 0) product.pop_back();
+}
+
+void ProductTree(std::vector<unsigned long long>& product, const std::vector<unsigned long long>& words, const std::vector<int>& offsets, int first, int last)
+{
+	//product = factor[first] * ... * factor[last - 1], where factor i is the unsigned magnitude held in words[offsets[i]] up to
+	//words[offsets[i + 1]]. The range gets split in half and each half is multiplied out on its own, so every multiplication in the
+	//tree is between two numbers of about the same length instead of a long running product and one short factor.
+	if (last - first <= PRODUCT_TREE_LEAF)
+	{
+		product.assign(words.begin() + offsets[first], words.begin() + offsets[first + 1]);
+		std::vector<unsigned long long> partial;
+		for (int i = first + 1; i < last; i++)
+		{
+			int size = offsets[i + 1] - offsets[i];
+			if (size == 1)
+			{
+				unsigned long long carry = MultiplyWordsBySingle(product.data(), product.data(), product.size(), words[offsets[i]]);
+				if (carry) product.push_back(carry);
+			}
+			else
+			{
+				partial.resize(product.size() + size);
+				MultiplyMagnitudes(partial.data(), product.data(), product.size(), words.data() + offsets[i], size);
+				product.swap(partial);
+				TrimProduct(product);
+			}
+		}
+		return;
+	}
+
+	std::vector<unsigned long long> low, high;
+	int middle = first + (last - first) / 2;
+	ProductTree(low, words, offsets, first, middle);
+	ProductTree(high, words, offsets, middle, last);
+
+	product.resize(low.size() + high.size());
+	MultiplyMagnitudes(product.data(), low.data(), low.size(), high.data(), high.size());
+	TrimProduct(product);
+}
+
+void PackFactor(std::vector<unsigned long long>& words, unsigned long long& packed, unsigned long long num)
+{
+	//multiplies num into the word currently being packed, once that would overflow the packed word is added to the list of
+	//factors and a new one is started with num
+	unsigned long long high, low = MultiplyWords(packed, num, &high);
+	if (high)
+	{
+		words.push_back(packed);
+		packed = num;
+	}
+	else packed = low;
+}
+
+void MultiplyPacked(std::vector<unsigned long long>& product, std::vector<unsigned long long>& words, unsigned long long packed)
+{
+	//runs the product tree over a list of single word factors, the factor that was still being packed goes on the end
+	words.push_back(packed);
+	std::vector<int> offsets(words.size() + 1);
+	for (int i = 0; i < offsets.size(); i++) offsets[i] = i;
+	ProductTree(product, words, offsets, 0, words.size());
+}
+
+int_64x ShiftedProduct(const unsigned long long* product, int size, unsigned long long twos, bool negative)
+{
+	//returns +/- product * 2^twos, the shift is done on the words directly before they get stored
+	int word_shift = twos / 64, bit_shift = twos % 64;
+	std::vector<unsigned long long> shifted(size + word_shift + 1, 0);
+	for (int i = 0; i < size; i++)
+	{
+		shifted[i + word_shift] |= product[i] << bit_shift;
+		shifted[i + word_shift + 1] = bit_shift ? product[i] >> (64 - bit_shift) : 0;
+	}
+
+	int_64x answer;
+	StoreMagnitude(answer.digits, shifted.data(), shifted.size(), negative);
+	return answer;
+}
+
+//PRODUCT FUNCTIONS
+int_64x factorial(unsigned long long n)
+{
+	//The power of 2 in n! is n - (the number of 1 bits in n), so only the odd part of each factor needs to be multiplied in
+	std::vector<unsigned long long> words, product;
+	unsigned long long packed = 1;
+	for (unsigned long long i = 3; i <= n; i++) PackFactor(words, packed, i >> CountTrailingZeros(i));
+
+	MultiplyPacked(product, words, packed);
+	return ShiftedProduct(product.data(), product.size(), n - CountBits(n), false);
+}
+
+int_64x binomial(unsigned long long n, unsigned long long k)
+{
+	//C(n, k) = (n - k + 1) * ... * n / k!. Both products are made out of odd parts only and the power of 2 left over in C(n, k) is
+	//the number of carries when adding k and n - k in binary (Kummer's theorem), which works out to the difference in 1 bits.
+	if (k > n) return 0;
+	if (k > n - k) k = n - k;
+
+	std::vector<unsigned long long> numerator_words, denominator_words, numerator, denominator;
+	unsigned long long numerator_packed = 1, denominator_packed = 1;
+	for (unsigned long long i = 1; i <= k; i++)
+	{
+		unsigned long long factor = n - k + i;
+		PackFactor(numerator_words, numerator_packed, factor >> CountTrailingZeros(factor));
+		PackFactor(denominator_words, denominator_packed, i >> CountTrailingZeros(i));
+	}
+	MultiplyPacked(numerator, numerator_words, numerator_packed);
+	MultiplyPacked(denominator, denominator_words, denominator_packed);
+
+	//the odd part of k! always divides evenly into the odd part of the numerator
+	int quotient_size = numerator.size() - denominator.size() + 1;
+	std::vector<unsigned long long> quotient(quotient_size), remainder(denominator.size()), scratch(numerator.size() + denominator.size() + 1);
+	DivideWords(quotient.data(), remainder.data(), numerator.data(), numerator.size(), denominator.data(), denominator.size(), scratch.data());
+
+	return ShiftedProduct(quotient.data(), quotient_size, CountBits(k) + CountBits(n - k) - CountBits(n), false);
+}
+
+int_64x product(const int_64x* nums, int count)
+{
+	//Each number is split into its sign, the power of 2 that divides it and its odd magnitude. Odd magnitudes that fit into a single
+	//word are packed together the same way that factorial() packs its factors, longer ones go into the product tree as they are.
+	std::vector<unsigned long long> words, small_words, magnitude, product;
+	std::vector<int> offsets(1, 0);
+	unsigned long long packed = 1, twos = 0;
+	bool negative = false;
+
+	for (int i = 0; i < count; i++)
+	{
+		const int_64x_digits& digits = nums[i].digits;
+		if (digits.empty()) return 0;
+
+		magnitude.resize(digits.size());
+		int size = CopyMagnitude(digits, magnitude.data());
+		if (size == 1 && magnitude[0] == 0) return 0;
+		negative ^= (digits.back() >> 63);
+
+		int zero_words = 0;
+		while (magnitude[zero_words] == 0) zero_words++;
+		int bit_shift = CountTrailingZeros(magnitude[zero_words]);
+		twos += 64 * zero_words + bit_shift;
+
+		for (int j = zero_words; j < size; j++) magnitude[j - zero_words] = (magnitude[j] >> bit_shift) | ((bit_shift && j + 1 < size) ? magnitude[j + 1] << (64 - bit_shift) : 0);
+		size -= zero_words;
+		while (size > 1 && magnitude[size - 1] == 0) size--;
+
+		if (size == 1) PackFactor(small_words, packed, magnitude[0]);
+		else
+		{
+			words.insert(words.end(), magnitude.begin(), magnitude.begin() + size);
+			offsets.push_back(words.size());
+		}
+	}
+
+	small_words.push_back(packed);
+	for (int i = 0; i < small_words.size(); i++)
+	{
+		words.push_back(small_words[i]);
+		offsets.push_back(words.size());
+	}
+
+	ProductTree(product, words, offsets, 0, offsets.size() - 1);
+	return ShiftedProduct(product.data(), product.size(), twos, negative);
+}
+int_64x product(const std::vector<int_64x>& nums)
+{
+	return product(nums.data(), nums.size());
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <Header_Files/int_64x_modular.h>
+#include <vector>
+
+//NUMBER THEORY FUNCTIONS
+//These are built straight on top of the word array kernels in int_64x.cpp instead of the arithmetic operators so that the inner
+//loops don't create (and allocate) a new int_64x for every step.
+
+//GCD Functions
+//gcd() and lcm() always return a number that's 0 or positive, gcd(0, 0) = 0 and lcm(0, x) = 0. Numbers that fit into a single word
+//(or two words when the compiler has a native 128-bit type) use binary GCD, which only needs shifts and subtractions. Anything larger
+//uses Lehmer's method: the leading 62 bits of both numbers (taken from across the top two words) are run through Euclid's algorithm
+//with single word arithmetic for as long as the quotients are guaranteed to match the ones for the full numbers, and then all of
+//those steps are applied to the full numbers at once with a 2x2 matrix of single word cofactors. A full division is only needed when
+//the leading bits can't make any progress (i.e. when one number is a lot bigger than the other).
+//
+//There's no sub-quadratic half-GCD here, it only pays off on top of sub-quadratic multiplication and int_64x multiplication is
+//schoolbook at every size.
+int_64x gcd(const int_64x& num1, const int_64x& num2);
+int_64x lcm(const int_64x& num1, const int_64x& num2);
+int_64x gcdext(int_64x& s, int_64x& t, const int_64x& num1, const int_64x& num2); //returns g = gcd(num1, num2) and sets num1 * s + num2 * t = g
+bool invert(int_64x& result, const int_64x& num, const int_64x& modulus); //result = num^-1 mod modulus in [0, modulus), false if there isn't one
+
+//batch_invert() replaces every number in nums with its inverse mod modulus using Montgomery's simultaneous inversion trick: the
+//running products a1, a1*a2, a1*a2*a3, ... are found, only the final product gets inverted with gcdext(), and then walking back down
+//the list each inverse is peeled off with two multiplications. That's one extended GCD plus about 3n modular multiplications for
+//the whole batch instead of n extended GCD's. Any number without an inverse is set to 0 and gets false in the returned vector, the
+//rest of the batch is still inverted (a batch that contains non-invertible numbers gets split in half until they're isolated). The
+//modulus needs to be greater than 0, otherwise nums is left alone and every entry of the returned vector is false.
+std::vector<bool> batch_invert(int_64x* nums, int count, const int_64x& modulus);
+std::vector<bool> batch_invert(std::vector<int_64x>& nums, const int_64x& modulus);
+
+//Root Functions
+//isqrt() and iroot() return floor(num^(1/k)) (rounded towards 0 for odd roots of negative numbers). They use Newton's method on top
+//of the regular division, starting from an estimate built out of the lead bit location of num and a floating point root of its top
+//64 bits so only a few steps are ever needed. k needs to be at least 1 and num can only be negative for odd roots, anything else
+//returns 0. is_square() tries a few single word residue tests before it takes any roots.
+int_64x isqrt(const int_64x& num);
+int_64x iroot(const int_64x& num, int k);
+bool is_square(const int_64x& num);
+bool is_perfect_power(const int_64x& num);
+
+//Primality Functions
+//is_probable_prime() starts with trial division by every prime below 1000. The primes are packed into groups whose product fits into
+//a single word, so each group only costs one pass of DivideWordsBySingle() over num followed by a few single word remainders. Anything
+//that gets through is given the Baillie-PSW test (a strong Fermat test to base 2 followed by a strong Lucas test), which has no known
+//counterexamples. extra_rounds adds that many more Miller-Rabin rounds using the odd primes 3, 5, 7, ... as bases. All of the
+//modular arithmetic is done in Montgomery form on word buffers with a single montgomery_context.
+//
+//The vector version tests a whole batch of candidates spread out over "threads" threads (0 means one per hardware thread). Each
+//thread grabs the next untested candidate when it finishes one, and since workspaces are per thread nothing is shared between them
+//other than the list of candidates.
+bool is_probable_prime(const int_64x& num, int extra_rounds = 0);
+std::vector<bool> is_probable_prime(const std::vector<int_64x>& candidates, int extra_rounds = 0, int threads = 0);
+
+//Product Functions
+//Multiplying a long list of numbers together one at a time means multiplying an accumulator that keeps getting longer by factors
+//that stay short, which is the slowest way to do it. These pull the powers of 2 out of every factor first (they come back as a single
+//shift at the end), pack the odd parts of factors that fit into a word together until each packed word is full, and then multiply
+//the packed words with a balanced product tree so each multiplication is between two numbers of about the same size. binomial()
+//divides the odd part of k! out of the odd part of (n - k + 1) * ... * n with a single long division.
+int_64x factorial(unsigned long long n);
+int_64x binomial(unsigned long long n, unsigned long long k); //0 when k > n
+int_64x product(const int_64x* nums, int count); //the product of an empty list is 1
+int_64x product(const std::vector<int_64x>& nums);
+
+//Related Functions
+unsigned long long BinaryGCD(unsigned long long num1, unsigned long long num2);
+int JacobiSymbol(long long num, const int_64x& n); //(num / n) for an odd positive n
+int TrialDivision(const int_64x& num); //-1 if a prime below 1000 divides num, 1 if num is one of those primes, 0 otherwise
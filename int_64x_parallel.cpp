@@ -0,0 +1,189 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_parallel.h>
+#include <algorithm>
+
+//PARALLEL SCOPES
+static thread_local const int_64x_parallel_settings* current_parallel_settings = nullptr;
+
+int_64x_parallel_scope::int_64x_parallel_scope(const int_64x_parallel_settings& settings) : settings(settings)
+{
+	if (this->settings.grain_words < 1) this->settings.grain_words = 1;
+	previous = current_parallel_settings;
+	current_parallel_settings = &this->settings;
+}
+int_64x_parallel_scope::~int_64x_parallel_scope()
+{
+	current_parallel_settings = previous;
+}
+const int_64x_parallel_settings* int_64x_parallel_scope::active()
+{
+	return current_parallel_settings;
+}
+
+//THREAD POOL
+//set while a thread is working on a batch so that a task that calls run() itself doesn't try to start a second batch
+static thread_local bool running_batch = false;
+
+int_64x_thread_pool::int_64x_thread_pool(int workers) : queues(new task_queue[(workers > 0 ? workers : 0) + 1]), batch_task(nullptr), batch_threads(0),
+	busy_workers(0), generation(0), stopping(false)
+{
+	for (int i = 1; i <= workers; i++) this->workers.emplace_back(&int_64x_thread_pool::workerLoop, this, i);
+}
+int_64x_thread_pool::~int_64x_thread_pool()
+{
+	{
+		std::lock_guard<std::mutex> state(state_lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (int i = 0; i < workers.size(); i++) workers[i].join();
+}
+int int_64x_thread_pool::threads() const
+{
+	return workers.size() + 1;
+}
+int_64x_thread_pool& int_64x_thread_pool::shared()
+{
+	static int_64x_thread_pool pool(std::max((int)std::thread::hardware_concurrency(), 1) - 1);
+	return pool;
+}
+
+void int_64x_thread_pool::run(const std::function<void(int)>& task, int task_count, int max_threads)
+{
+	if (task_count <= 0) return;
+
+	int thread_count = (max_threads > 0) ? std::min(max_threads, threads()) : threads();
+	thread_count = std::min(thread_count, task_count);
+
+	std::unique_lock<std::mutex> batch(batch_lock, std::defer_lock);
+	if (thread_count > 1 && !running_batch) batch.try_lock();
+	if (!batch.owns_lock())
+	{
+		for (int i = 0; i < task_count; i++) task(i);
+		return;
+	}
+
+	//each thread starts out with a block of tasks that are next to each other, anything left over gets stolen at the end
+	for (int i = 0; i < thread_count; i++)
+	{
+		std::lock_guard<std::mutex> queue(queues[i].lock);
+		queues[i].tasks.clear();
+		for (int j = (long long)i * task_count / thread_count; j < (long long)(i + 1) * task_count / thread_count; j++) queues[i].tasks.push_back(j);
+	}
+
+	{
+		std::lock_guard<std::mutex> state(state_lock);
+		batch_task = &task;
+		batch_threads = thread_count;
+		busy_workers = thread_count - 1;
+		generation++;
+	}
+	wake.notify_all();
+
+	work(0);
+
+	std::unique_lock<std::mutex> state(state_lock);
+	finished.wait(state, [this] { return busy_workers == 0; });
+	batch_task = nullptr;
+}
+
+bool int_64x_thread_pool::nextTask(int queue, int& task)
+{
+	{
+		std::lock_guard<std::mutex> own(queues[queue].lock);
+		if (!queues[queue].tasks.empty())
+		{
+			task = queues[queue].tasks.front();
+			queues[queue].tasks.pop_front();
+			return true;
+		}
+	}
+
+	for (int i = 1; i < batch_threads; i++)
+	{
+		task_queue& victim = queues[(queue + i) % batch_threads];
+		std::lock_guard<std::mutex> other(victim.lock);
+		if (!victim.tasks.empty())
+		{
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+void int_64x_thread_pool::work(int queue)
+{
+	running_batch = true;
+	int task;
+	while (nextTask(queue, task)) (*batch_task)(task);
+	running_batch = false;
+}
+void int_64x_thread_pool::workerLoop(int worker)
+{
+	unsigned long long seen = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> state(state_lock);
+			wake.wait(state, [&] { return stopping || (generation != seen && worker < batch_threads); });
+			if (stopping) return;
+			seen = generation;
+		}
+
+		work(worker);
+
+		std::lock_guard<std::mutex> state(state_lock);
+		if (--busy_workers == 0) finished.notify_all();
+	}
+}
+
+//PARALLEL MULTIPLICATION
+bool UseParallelMultiplication(int num1_size, int num2_size, const int_64x_parallel_settings* settings)
+{
+	return settings && num1_size >= settings->min_words && num2_size >= settings->min_words && int_64x_thread_pool::shared().threads() > 1 &&
+		settings->threads != 1;
+}
+void ParallelMultiplyMagnitudes(unsigned long long* product, const unsigned long long* num1, int num1_size, const unsigned long long* num2, int num2_size,
+	const int_64x_parallel_settings& settings)
+{
+	int product_size = num1_size + num2_size, grain = std::max(settings.grain_words, 1);
+	int task_count = (product_size + grain - 1) / grain;
+	std::vector<unsigned long long> overflow(2 * task_count);
+
+	int_64x_thread_pool::shared().run([&](int task)
+	{
+		//Every row num1 * num2[j] that reaches into columns [first, last) gets added into a buffer that's two words longer than
+		//the columns. Each row is less than 2^(64 * (width + 1)) so even all num2_size of them can't overflow the two extra words.
+		int first = task * grain, last = std::min(first + grain, product_size), width = last - first;
+		unsigned long long* columns = int_64x_workspace::local().buffer(int_64x_workspace::SCRATCH, width + 2);
+		for (int i = 0; i < width + 2; i++) columns[i] = 0;
+
+		for (int j = std::max(0, first - num1_size + 1); j < std::min(num2_size, last); j++)
+		{
+			int start = std::max(0, first - j), end = std::min(num1_size, last - j);
+			unsigned long long carry = MultiplyAddWords(columns + (start + j - first), num1 + start, end - start, num2[j]);
+			AddWordAt(columns, width + 2, end + j - first, carry);
+		}
+
+		for (int i = 0; i < width; i++) product[first + i] = columns[i];
+		overflow[2 * task] = columns[width];
+		overflow[2 * task + 1] = columns[width + 1];
+	}, task_count, settings.threads);
+
+	//the overflow out of the last task is always 0 since the product fits into num1_size + num2_size words
+	for (int task = 0; task < task_count - 1; task++)
+	{
+		int last = (task + 1) * grain;
+		AddWordAt(product, product_size, last, overflow[2 * task]);
+		AddWordAt(product, product_size, last + 1, overflow[2 * task + 1]);
+	}
+}
+
+int_64x multiply_parallel(const int_64x& num1, const int_64x& num2, const int_64x_parallel_settings& settings)
+{
+	int_64x_parallel_scope scope(settings);
+	int_64x answer = num1;
+	answer *= num2;
+	return answer;
+}
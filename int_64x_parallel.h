@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//PARALLEL MULTIPLICATION
+//A single multiplication of two very long numbers only ever runs on the thread that asked for it. When an int_64x_parallel_scope is
+//active on a thread, multiplications on that thread where both numbers are at least min_words long get split up and spread over the
+//shared int_64x_thread_pool instead. int_64x multiplication is schoolbook at every size (there's no Karatsuba, Toom or NTT to split up
+//into sub-products) so the work is divided by columns of the product: each task works out grain_words words of the product, adding in
+//every partial product that lands in those words, and hands back the two words that overflow past the end of its columns. Once every
+//task is done the overflow words are added in one after the other from the bottom of the product to the top.
+//
+//Since the columns each task covers only depend on grain_words and the overflow words are always added in the same order, the answer
+//(and every intermediate word) is exactly the same no matter how many threads end up being used or which thread runs which task.
+struct int_64x_parallel_settings
+{
+	int threads = 0; //the most threads (including the calling one) a single multiplication can use, 0 means every thread of the pool
+	int min_words = 256; //both numbers need at least this many words before the multiplication gets split up
+	int grain_words = 128; //the number of product words worked out by each task
+};
+
+//Scopes can be nested, the settings of the innermost one are the ones that get used
+class int_64x_parallel_scope
+{
+public:
+	int_64x_parallel_scope(const int_64x_parallel_settings& settings = int_64x_parallel_settings());
+	~int_64x_parallel_scope();
+	int_64x_parallel_scope(const int_64x_parallel_scope&) = delete;
+	int_64x_parallel_scope& operator=(const int_64x_parallel_scope&) = delete;
+
+	static const int_64x_parallel_settings* active(); //the settings for the current thread, nullptr if there's no scope
+
+private:
+	const int_64x_parallel_settings* previous;
+	int_64x_parallel_settings settings;
+};
+
+//The int_64x_thread_pool is a small work-stealing pool. run() deals the tasks of a batch out to one queue for each thread taking part
+//(the calling thread is one of them), every thread works through its own queue from the front and once it's empty steals from the
+//back of the other queues until there's nothing left. Tasks are only ever handed out by run(), so a thread that finds every queue
+//empty is done. Only one batch runs on the pool at a time: if run() is called while the pool is busy (or from inside of a task) the
+//tasks are just run one after the other on the calling thread.
+class int_64x_thread_pool
+{
+public:
+	int_64x_thread_pool(int workers);
+	~int_64x_thread_pool();
+	int_64x_thread_pool(const int_64x_thread_pool&) = delete;
+	int_64x_thread_pool& operator=(const int_64x_thread_pool&) = delete;
+
+	int threads() const; //the number of worker threads plus one for the thread that calls run()
+	void run(const std::function<void(int)>& task, int task_count, int max_threads = 0); //calls task(0) ... task(task_count - 1)
+
+	static int_64x_thread_pool& shared(); //a pool with a worker for every hardware thread other than the calling one
+
+private:
+	struct task_queue
+	{
+		std::mutex lock;
+		std::deque<int> tasks;
+	};
+
+	bool nextTask(int queue, int& task);
+	void work(int queue);
+	void workerLoop(int worker);
+
+	std::vector<std::thread> workers;
+	std::unique_ptr<task_queue[]> queues;
+	std::mutex batch_lock, state_lock;
+	std::condition_variable wake, finished;
+	const std::function<void(int)>* batch_task;
+	int batch_threads; //the number of threads taking part in the current batch
+	int busy_workers;
+	unsigned long long generation; //goes up by one with every batch so the workers can tell a new batch apart from the last one
+	bool stopping;
+};
+
+//Related Functions
+bool UseParallelMultiplication(int num1_size, int num2_size, const int_64x_parallel_settings* settings);
+void ParallelMultiplyMagnitudes(unsigned long long* product, const unsigned long long* num1, int num1_size, const unsigned long long* num2, int num2_size,
+	const int_64x_parallel_settings& settings); //same as MultiplyMagnitudes()
+
+//num1 * num2 with the given settings used for just this one multiplication
+int_64x multiply_parallel(const int_64x& num1, const int_64x& num2, const int_64x_parallel_settings& settings = int_64x_parallel_settings());
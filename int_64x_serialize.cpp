@@ -0,0 +1,337 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_serialize.h>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const unsigned char SERIALIZE_MAGIC[4] = { 'I', '6', '4', 'X' };
+const unsigned char SERIALIZE_END_MAGIC[8] = { 'I', '6', '4', 'X', 'E', 'N', 'D', 0 };
+const int SERIALIZE_HEADER_SIZE = 8, SERIALIZE_FOOTER_SIZE = 24;
+const unsigned long long SERIALIZE_END_MARKER = 1;
+
+//VARINTS
+int WriteVarint(unsigned char* buffer, unsigned long long value)
+{
+	int size = 0;
+	while (value >= 0x80)
+	{
+		buffer[size++] = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	buffer[size++] = (unsigned char)value;
+	return size;
+}
+int ReadVarint(const unsigned char* buffer, unsigned long long available, unsigned long long& value)
+{
+	value = 0;
+	for (int i = 0; i < 10 && i < available; i++)
+	{
+		value |= (unsigned long long)(buffer[i] & 0x7F) << (7 * i);
+		if (!(buffer[i] & 0x80)) return i + 1;
+	}
+	return 0;
+}
+unsigned long long PaddingTo8(unsigned long long position)
+{
+	return (8 - position % 8) % 8;
+}
+
+//WRITER
+int_64x_writer::int_64x_writer(std::ostream& stream, bool index) : stream(stream), position(0), values(0), index(index), finished(false)
+{
+	unsigned char header[SERIALIZE_HEADER_SIZE] = { SERIALIZE_MAGIC[0], SERIALIZE_MAGIC[1], SERIALIZE_MAGIC[2], SERIALIZE_MAGIC[3],
+		(unsigned char)SERIALIZE_VERSION, (unsigned char)(index ? 1 : 0), 0, 0 };
+	writeBytes(header, SERIALIZE_HEADER_SIZE);
+}
+int_64x_writer::~int_64x_writer()
+{
+	finish();
+}
+void int_64x_writer::writeBytes(const void* bytes, size_t size)
+{
+	stream.write((const char*)bytes, size);
+	position += size;
+}
+void int_64x_writer::pad()
+{
+	static const unsigned char zeros[8] = { 0 };
+	writeBytes(zeros, PaddingTo8(position));
+}
+void int_64x_writer::write(const int_64x& num)
+{
+	if (finished) return;
+
+	int size = 0;
+	bool negative = false;
+	if (!num.digits.empty())
+	{
+		magnitude.resize(num.digits.size());
+		size = CopyMagnitude(num.digits, magnitude.data());
+		if (size == 1 && magnitude[0] == 0) size = 0;
+		negative = size && (num.digits.back() >> 63);
+	}
+
+	if (index) offsets.push_back(position);
+	unsigned char header[10];
+	writeBytes(header, WriteVarint(header, ((unsigned long long)size << 1) | negative));
+	pad();
+	writeBytes(magnitude.data(), (size_t)size * sizeof(unsigned long long));
+	values++;
+}
+void int_64x_writer::finish()
+{
+	if (finished) return;
+	finished = true;
+
+	unsigned char marker[10];
+	writeBytes(marker, WriteVarint(marker, SERIALIZE_END_MARKER));
+	pad();
+
+	unsigned long long footer[2] = { values, index ? position : 0 };
+	if (index) writeBytes(offsets.data(), offsets.size() * sizeof(unsigned long long));
+	writeBytes(footer, sizeof(footer));
+	writeBytes(SERIALIZE_END_MAGIC, sizeof(SERIALIZE_END_MAGIC));
+	stream.flush();
+}
+unsigned long long int_64x_writer::count() const
+{
+	return values;
+}
+
+//READER
+int_64x_reader::int_64x_reader(std::istream& stream) : stream(stream), position(0), values(0), problem(SERIALIZE_OK), good(true), done(false),
+	indexed(false)
+{
+	unsigned char header[SERIALIZE_HEADER_SIZE];
+	if (!readBytes(header, SERIALIZE_HEADER_SIZE) || std::memcmp(header, SERIALIZE_MAGIC, 4) || header[4] != SERIALIZE_VERSION) fail(SERIALIZE_BAD_HEADER);
+	indexed = good && (header[5] & 1);
+}
+bool int_64x_reader::valid() const
+{
+	return good;
+}
+int_64x_serialize_error int_64x_reader::error() const
+{
+	return problem;
+}
+bool int_64x_reader::fail(int_64x_serialize_error reason)
+{
+	problem = reason;
+	good = false;
+	return false;
+}
+bool int_64x_reader::readBytes(void* bytes, size_t size)
+{
+	stream.read((char*)bytes, size);
+	position += stream.gcount();
+	return stream.gcount() == size;
+}
+bool int_64x_reader::skipPadding()
+{
+	unsigned char padding[8];
+	return readBytes(padding, PaddingTo8(position));
+}
+bool int_64x_reader::read(int_64x& num)
+{
+	if (!good || done) return false;
+
+	//the varint is read a byte at a time since the stream can't be peeked ahead
+	unsigned long long header = 0;
+	unsigned char byte = 0x80;
+	for (int i = 0; i < 10 && (byte & 0x80); i++)
+	{
+		if (!readBytes(&byte, 1)) break;
+		header |= (unsigned long long)(byte & 0x7F) << (7 * i);
+	}
+	if ((byte & 0x80) || (header >> 1) > 0x7FFFFFFF || !skipPadding()) return fail(SERIALIZE_CUT_OFF);
+
+	if (header == SERIALIZE_END_MARKER)
+	{
+		//the index isn't needed here but it has to be skipped over to check that the footer matches what was read
+		done = true;
+		std::vector<unsigned char> ending(8 * (indexed ? values : 0) + SERIALIZE_FOOTER_SIZE);
+		unsigned long long footer_count = 0;
+		if (readBytes(ending.data(), ending.size())) std::memcpy(&footer_count, ending.data() + ending.size() - SERIALIZE_FOOTER_SIZE, 8);
+		if (stream.gcount() != ending.size() || footer_count != values || std::memcmp(ending.data() + ending.size() - 8, SERIALIZE_END_MAGIC, 8))
+			fail(SERIALIZE_BAD_FOOTER);
+		return false;
+	}
+	values++;
+
+	int size = header >> 1;
+	if (size == 0)
+	{
+		num = 0;
+		return true;
+	}
+
+	//The size in the header hasn't been checked against anything yet, so the magnitude is read into a buffer that only grows one chunk
+	//ahead of the words that have actually arrived. num isn't touched until the whole record is there.
+	for (int words_read = 0; words_read < size;)
+	{
+		int chunk = (size - words_read < SERIALIZE_READ_CHUNK) ? size - words_read : SERIALIZE_READ_CHUNK;
+		magnitude.resize(words_read + chunk);
+		if (!readBytes(magnitude.data() + words_read, (size_t)chunk * sizeof(unsigned long long))) return fail(SERIALIZE_CUT_OFF);
+		words_read += chunk;
+	}
+	StoreMagnitude(num.digits, magnitude.data(), size, header & 1);
+	return true;
+}
+
+//MAPPED FILES
+int_64x int_64x_record::value() const
+{
+	int_64x answer = 0;
+	if (size) StoreMagnitude(answer.digits, limbs, size, negative);
+	return answer;
+}
+
+int_64x_mapped_file::int_64x_mapped_file(const std::string& path) : data(nullptr), bytes(0), record_count(0), index_offset(0),
+	cursor(SERIALIZE_HEADER_SIZE), problem(SERIALIZE_OK), good(false)
+{
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		{
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping)
+			{
+				data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				if (data) bytes = size.QuadPart;
+				CloseHandle(mapping); //the view keeps the mapping alive
+			}
+		}
+		CloseHandle(file);
+	}
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file >= 0)
+	{
+		struct stat status;
+		if (fstat(file, &status) == 0 && status.st_size > 0)
+		{
+			void* mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (mapping != MAP_FAILED)
+			{
+				data = (const unsigned char*)mapping;
+				bytes = status.st_size;
+			}
+		}
+		close(file); //the mapping stays around after the file is closed
+	}
+#endif
+
+	if (!data)
+	{
+		problem = SERIALIZE_MAP_FAILED;
+		return;
+	}
+
+	//the header, the end marker and the footer all need to be there, and the index (if there is one) has to fit in between
+	if (bytes < SERIALIZE_HEADER_SIZE + 8 + SERIALIZE_FOOTER_SIZE || std::memcmp(data, SERIALIZE_MAGIC, 4) || data[4] != SERIALIZE_VERSION ||
+		std::memcmp(data + bytes - 8, SERIALIZE_END_MAGIC, 8))
+	{
+		problem = SERIALIZE_BAD_HEADER;
+		return;
+	}
+	std::memcpy(&record_count, data + bytes - SERIALIZE_FOOTER_SIZE, 8);
+	std::memcpy(&index_offset, data + bytes - SERIALIZE_FOOTER_SIZE + 8, 8);
+	if ((data[5] & 1) != (index_offset != 0) || (index_offset && (index_offset % 8 || index_offset > bytes - SERIALIZE_FOOTER_SIZE ||
+		(bytes - SERIALIZE_FOOTER_SIZE - index_offset) / 8 != record_count)))
+	{
+		problem = SERIALIZE_BAD_FOOTER;
+		return;
+	}
+	good = true;
+}
+int_64x_mapped_file::~int_64x_mapped_file()
+{
+	if (!data) return;
+#if defined(_WIN32)
+	UnmapViewOfFile(data);
+#else
+	munmap((void*)data, bytes);
+#endif
+}
+
+bool int_64x_mapped_file::valid() const
+{
+	return good;
+}
+int_64x_serialize_error int_64x_mapped_file::error() const
+{
+	return problem;
+}
+bool int_64x_mapped_file::indexed() const
+{
+	return good && index_offset;
+}
+unsigned long long int_64x_mapped_file::count() const
+{
+	return record_count;
+}
+
+bool int_64x_mapped_file::parse(unsigned long long offset, int_64x_record& record, unsigned long long* next_offset) const
+{
+	//records all live between the header and the footer (or the index), anything that runs past that is a broken file
+	unsigned long long end = index_offset ? index_offset : bytes - SERIALIZE_FOOTER_SIZE, header;
+	int length = (offset < end) ? ReadVarint(data + offset, end - offset, header) : 0;
+	if (!length) return false;
+	if (header == SERIALIZE_END_MARKER) return false;
+
+	unsigned long long start = offset + length;
+	start += PaddingTo8(start);
+	unsigned long long size = header >> 1;
+	if (start > end || size > (end - start) / 8) return false;
+
+	record.limbs = (const unsigned long long*)(data + start);
+	record.size = size;
+	record.negative = header & 1;
+	if (next_offset) *next_offset = start + 8 * size;
+	return true;
+}
+bool int_64x_mapped_file::next(int_64x_record& record)
+{
+	return good && parse(cursor, record, &cursor);
+}
+void int_64x_mapped_file::rewind()
+{
+	cursor = SERIALIZE_HEADER_SIZE;
+}
+bool int_64x_mapped_file::record(unsigned long long index, int_64x_record& record) const
+{
+	if (!indexed() || index >= record_count) return false;
+
+	unsigned long long offset;
+	std::memcpy(&offset, data + index_offset + 8 * index, 8);
+	return parse(offset, record, nullptr);
+}
+
+//STREAMS
+void serialize(std::ostream& stream, const std::vector<int_64x>& nums, bool index)
+{
+	int_64x_writer writer(stream, index);
+	for (int i = 0; i < nums.size(); i++) writer.write(nums[i]);
+	writer.finish();
+}
+bool deserialize(std::istream& stream, std::vector<int_64x>& nums)
+{
+	int_64x_reader reader(stream);
+	int_64x num;
+	nums.clear();
+	while (reader.read(num)) nums.push_back(num);
+	return reader.valid();
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//BINARY FORMAT
+//Writing numbers out with getNumberString() means converting every one of them into base 10 (which is slow for big numbers) and the
+//text ends up about 2.4 times the size of the words themselves. The binary format here stores the words directly:
+//
+//    header:  the 4 bytes "I64X", a version byte, a flags byte (bit 0 is set if there's an index) and 2 reserved 0 bytes
+//    records: one for each number, made up of a varint (7 bits to a byte, low bits first, the top bit of a byte means more bytes are
+//             coming) holding (number of words << 1) | sign, then 0 bytes up to the next multiple of 8 from the start of the file,
+//             then the words of the magnitude of the number in little endian order (0 is a record with no words)
+//    end:     a single varint of 1 (no words with the sign set, which no number ever uses), then 0 bytes up to a multiple of 8
+//    index:   only if the flag is set, the offset of every record from the start of the file as little endian 64-bit words
+//    footer:  the number of records and the offset of the index (0 if there isn't one) as little endian 64-bit words, then the 8
+//             bytes "I64XEND" followed by a 0 byte
+//
+//Padding each record so its words start on a multiple of 8 costs a few bytes per number but it means a file that's mapped into
+//memory (which always starts on a page boundary) can have its words read in place. The words are written straight out of memory,
+//which is little endian on every platform int_64x is built for.
+const int SERIALIZE_VERSION = 1;
+const int SERIALIZE_READ_CHUNK = 1 << 16; //the most words a reader pulls out of the stream at once
+
+//When a reader or a mapped file stops being valid, error() says what went wrong.
+enum int_64x_serialize_error { SERIALIZE_OK, SERIALIZE_BAD_HEADER, SERIALIZE_CUT_OFF, SERIALIZE_BAD_FOOTER, SERIALIZE_MAP_FAILED };
+
+//int_64x_writer writes the header when it's created and the end marker, index and footer when finish() is called (or when it's
+//destroyed). The index just costs 8 bytes for each number but without it the numbers can only be read back in order. Any numbers
+//written after the writer has been finished are ignored.
+class int_64x_writer
+{
+public:
+	int_64x_writer(std::ostream& stream, bool index = false);
+	~int_64x_writer();
+	int_64x_writer(const int_64x_writer&) = delete;
+	int_64x_writer& operator=(const int_64x_writer&) = delete;
+
+	void write(const int_64x& num);
+	void finish();
+	unsigned long long count() const;
+
+private:
+	void writeBytes(const void* bytes, size_t size);
+	void pad();
+
+	std::ostream& stream;
+	std::vector<unsigned long long> offsets; //only filled in when there's an index
+	std::vector<unsigned long long> magnitude;
+	unsigned long long position; //bytes written since the start of the header
+	unsigned long long values;
+	bool index, finished;
+};
+
+//int_64x_reader reads the records back out of a stream one at a time. The index is skipped over and the footer is only used to check
+//that the stream wasn't cut off. The words of a record are read a chunk at a time and num only grows as they actually arrive, so a
+//record that claims to be much bigger than the stream really is just makes the reader fail instead of allocating all of it up front.
+class int_64x_reader
+{
+public:
+	int_64x_reader(std::istream& stream);
+
+	bool valid() const; //false if the header or footer was wrong or a record was cut off
+	int_64x_serialize_error error() const;
+	bool read(int_64x& num); //false once the end marker is reached (or the stream has a problem), num is left alone when it's false
+
+private:
+	bool readBytes(void* bytes, size_t size);
+	bool skipPadding();
+	bool fail(int_64x_serialize_error reason); //always returns false
+
+	std::istream& stream;
+	std::vector<unsigned long long> magnitude; //the words of the record being read
+	unsigned long long position;
+	unsigned long long values; //the number of records read so far
+	int_64x_serialize_error problem;
+	bool good, done, indexed;
+};
+
+//A record read out of a mapped file. limbs points straight into the mapping, so it's only good for as long as the file stays mapped.
+struct int_64x_record
+{
+	const unsigned long long* limbs; //the words of the magnitude
+	int size;
+	bool negative;
+
+	int_64x value() const;
+};
+
+//int_64x_mapped_file maps a whole file into memory (mmap, or MapViewOfFile on Windows) and hands out records that point straight at
+//the words inside of the mapping without copying anything. next() walks through the records in order, and when the file has an index
+//record() jumps straight to any one of them.
+class int_64x_mapped_file
+{
+public:
+	int_64x_mapped_file(const std::string& path);
+	~int_64x_mapped_file();
+	int_64x_mapped_file(const int_64x_mapped_file&) = delete;
+	int_64x_mapped_file& operator=(const int_64x_mapped_file&) = delete;
+
+	bool valid() const;
+	int_64x_serialize_error error() const;
+	bool indexed() const;
+	unsigned long long count() const; //the number of records in the file
+
+	bool next(int_64x_record& record); //false once every record has been read (or a record runs past the end of the file)
+	void rewind();
+	bool record(unsigned long long index, int_64x_record& record) const; //needs an index, false if index isn't less than count()
+
+private:
+	bool parse(unsigned long long offset, int_64x_record& record, unsigned long long* next_offset) const;
+
+	const unsigned char* data;
+	unsigned long long bytes;
+	unsigned long long record_count;
+	unsigned long long index_offset;
+	unsigned long long cursor;
+	int_64x_serialize_error problem;
+	bool good;
+};
+
+//Related Functions
+void serialize(std::ostream& stream, const std::vector<int_64x>& nums, bool index = false);
+bool deserialize(std::istream& stream, std::vector<int_64x>& nums); //false if the stream didn't hold a complete file
+int WriteVarint(unsigned char* buffer, unsigned long long value); //returns the number of bytes used, at most 10
+int ReadVarint(const unsigned char* buffer, unsigned long long available, unsigned long long& value); //returns the number of bytes used, 0 if it's bad
@@ -0,0 +1,99 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_series.h>
+#include <Header_Files/int_64x_parallel.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+//BINARY SPLITTING HELPERS
+void FreeNumber(int_64x& num)
+{
+	num.digits.clear();
+	num.digits.shrink_to_fit();
+	num.digits.push_back(0);
+}
+
+void CombineSeriesSums(int_64x_series_sum& left, int_64x_series_sum& right, bool need_p)
+{
+	//T = T1 * Q2 + P1 * T2, Q = Q1 * Q2 and P = P1 * P2. Everything from the right hand range is freed as soon as it's been used
+	//for the last time.
+	left.T *= right.Q;
+	right.T *= left.P;
+	left.T += right.T;
+	FreeNumber(right.T);
+
+	left.Q *= right.Q;
+	FreeNumber(right.Q);
+
+	if (need_p) left.P *= right.P;
+	else FreeNumber(left.P);
+	FreeNumber(right.P);
+}
+
+void BinarySplitRange(int_64x_series_sum& sum, const int_64x_series_term& term, unsigned long long first, unsigned long long last, bool need_p)
+{
+	if (last <= first)
+	{
+		sum.P = 1;
+		sum.Q = 1;
+		sum.T = 0;
+		return;
+	}
+	if (last - first == 1)
+	{
+		int_64x a;
+		term(first, sum.P, sum.Q, a);
+		sum.T = sum.P * a;
+		if (!need_p) FreeNumber(sum.P);
+		return;
+	}
+
+	//the left half always needs its P for the T of the combined range
+	unsigned long long middle = first + (last - first) / 2;
+	int_64x_series_sum right;
+	BinarySplitRange(sum, term, first, middle, true);
+	BinarySplitRange(right, term, middle, last, need_p);
+	CombineSeriesSums(sum, right, need_p);
+}
+
+//BINARY SPLITTING
+int_64x_series_sum binary_split(const int_64x_series_term& term, unsigned long long first, unsigned long long last, bool need_p, int threads)
+{
+	int_64x_thread_pool& pool = int_64x_thread_pool::shared();
+	int thread_count = (threads > 0) ? std::min(threads, pool.threads()) : pool.threads();
+	unsigned long long count = (last > first) ? last - first : 0;
+
+	int pieces = 1;
+	while (pieces < 2 * thread_count && pieces < count) pieces *= 2;
+	if (thread_count == 1) pieces = 1;
+
+	//Every piece gets created on the thread that works it out so it uses the memory resource of that thread, and only the final
+	//answer is copied over to the memory resource of the calling thread. Piece i is on the right hand edge of the tree (and doesn't
+	//need its P) only if it's the last one.
+	std::vector<std::unique_ptr<int_64x_series_sum>> sums(pieces);
+	pool.run([&](int piece)
+	{
+		unsigned long long piece_first = first + (count / pieces) * piece + std::min((unsigned long long)piece, count % pieces);
+		unsigned long long piece_last = piece_first + count / pieces + (piece < count % pieces);
+		sums[piece].reset(new int_64x_series_sum());
+		BinarySplitRange(*sums[piece], term, piece_first, piece_last, need_p || piece != pieces - 1);
+	}, pieces, thread_count);
+
+	//each level combines the pairs of ranges that are "stride" apart into the left range of the pair
+	for (int stride = 1; stride < pieces; stride *= 2)
+	{
+		int pairs = pieces / (2 * stride);
+		pool.run([&](int pair)
+		{
+			int left = 2 * pair * stride, right = left + stride;
+			CombineSeriesSums(*sums[left], *sums[right], need_p || right + stride < pieces);
+			sums[right].reset();
+		}, pairs, thread_count);
+	}
+
+	int_64x_series_sum answer;
+	answer.P = need_p ? sums[0]->P : 0;
+	answer.Q = sums[0]->Q;
+	answer.T = sums[0]->T;
+	return answer;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <functional>
+
+//BINARY SPLITTING
+//Hypergeometric style series like the ones for pi and e have terms where each one is a small rational multiple of the one before it.
+//Adding the terms up one at a time means dividing a huge number by a small one for every term, binary splitting instead keeps the
+//partial sums as exact fractions and combines neighbouring ranges of terms with a product tree, so most of the work ends up in a
+//small number of multiplications between numbers of about the same size. The series is
+//
+//    S = sum from n = first to last - 1 of a(n) * (p(first) * ... * p(n)) / (q(first) * ... * q(n))
+//
+//and the term function fills in p(n), q(n) and a(n) for a given n. For the range [first, last) binary_split() returns
+//P = p(first) * ... * p(last - 1), Q = q(first) * ... * q(last - 1) and T with S = T / Q. The ranges [first, mid) and [mid, last)
+//combine as P = P1 * P2, Q = Q1 * Q2 and T = T1 * Q2 + P1 * T2. To get D digits of S just work out T * 10^D / Q at the end.
+//
+//P of the whole range is only worked out when need_p is true, otherwise it's left as 0. The same goes for every range along the
+//right hand edge of the tree, which is the only place it isn't needed. The numbers for each half are freed as soon as they've been
+//combined so the memory in use at any time is only a little more than the numbers at the current level of the tree.
+//
+//The top levels of the tree are split over the shared int_64x_thread_pool: the range gets cut into a power of 2 number of pieces
+//(about two for each thread so there's some work left to steal), each piece is run through the recursion on its own and then the
+//pieces are combined a level at a time with every combination on a level running at the same time. The final combination runs on the
+//calling thread, so an int_64x_parallel_scope around the call also splits up its multiplications. threads = 1 does everything on the
+//calling thread. When more than one thread is used the term function gets called from several threads at once.
+typedef std::function<void(unsigned long long n, int_64x& p, int_64x& q, int_64x& a)> int_64x_series_term;
+
+struct int_64x_series_sum
+{
+	int_64x P, Q, T;
+};
+
+int_64x_series_sum binary_split(const int_64x_series_term& term, unsigned long long first, unsigned long long last, bool need_p = false, int threads = 0);
+
+//Related Functions
+void BinarySplitRange(int_64x_series_sum& sum, const int_64x_series_term& term, unsigned long long first, unsigned long long last, bool need_p);
+void CombineSeriesSums(int_64x_series_sum& left, int_64x_series_sum& right, bool need_p); //left = [first, mid) + [mid, last), right gets freed
+void FreeNumber(int_64x& num); //gives the memory of num back, num is left as 0
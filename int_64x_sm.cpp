@@ -0,0 +1,448 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_sm.h>
+#include <iostream>
+
+//CONSTRUCTORS
+int_64x_sm::int_64x_sm()
+{
+	magnitude.push_back(0);
+	negative = false;
+}
+int_64x_sm::int_64x_sm(int number) : int_64x_sm((long long)number)
+{
+}
+int_64x_sm::int_64x_sm(unsigned int number) : int_64x_sm((unsigned long long)number)
+{
+}
+int_64x_sm::int_64x_sm(long long number)
+{
+	//the magnitude of a negative long long is found by negating it as an unsigned value, this works for the smallest long
+	//long as well since its magnitude (2^63) still fits into an unsigned long long
+	negative = number < 0;
+	magnitude.push_back(negative ? 0 - (unsigned long long)number : (unsigned long long)number);
+}
+int_64x_sm::int_64x_sm(unsigned long long number)
+{
+	magnitude.push_back(number);
+	negative = false;
+}
+int_64x_sm::int_64x_sm(std::string number)
+{
+	//Unlike the int_64x string constructor there's no need to build the number bit by bit. Since the magnitude is unsigned we can
+	//read up to 19 decimal digits at a time into a single word and then multiply what we have so far by the matching power of 10.
+	magnitude.push_back(0);
+	negative = false;
+
+	int start = 0;
+	if (number[0] == '-') start = 1;
+
+	unsigned long long chunk = 0, chunk_power = 1;
+	int chunk_length = 0;
+	for (int i = start; i <= number.length(); i++)
+	{
+		if (i < number.length())
+		{
+			if ((number[i] > 57) || (number[i] < 48))
+			{
+				std::cout << "Found something in the number that's not a real digit, skipping it." << std::endl;
+				continue;
+			}
+			chunk = 10 * chunk + (number[i] - 48);
+			chunk_power *= 10;
+			chunk_length++;
+		}
+
+		//add the chunk in whenever it's full and once more at the very end of the string
+		if (chunk_length == 19 || (i == number.length() && chunk_length))
+		{
+			unsigned long long carry = MultiplyWordsBySingle(magnitude.data(), magnitude.data(), magnitude.size(), chunk_power);
+			if (carry) magnitude.push_back(carry);
+			magnitude.push_back(0);
+			AddWordAt(magnitude.data(), magnitude.size(), 0, chunk);
+			removeLeadingZeros();
+
+			chunk = 0;
+			chunk_power = 1;
+			chunk_length = 0;
+		}
+	}
+
+	negative = (start == 1) && !isZero();
+}
+int_64x_sm::int_64x_sm(const int_64x& num)
+{
+	//a positive int_64x can be copied over as is. A negative one gets flipped to positive in the same pass as the copy by
+	//inverting each word and rippling the + 1 along as we go
+	negative = !num.digits.empty() && (num.digits.back() >> 63);
+	magnitude.assign(num.digits.begin(), num.digits.end());
+	if (magnitude.empty()) magnitude.push_back(0);
+
+	if (negative) NegateWords(magnitude.data(), magnitude.size());
+	removeLeadingZeros();
+}
+
+//CONVERSION
+int_64x int_64x_sm::to_int_64x() const
+{
+	//the reverse of the int_64x constructor. A 0 word is added first if the lead bit of the magnitude is a 1 so that there's room
+	//for the sign bit, then negative numbers are flipped in place
+	int_64x num;
+	num.digits.assign(magnitude.begin(), magnitude.end());
+	if (num.digits.back() >> 63) num.digits.push_back(0);
+
+	if (negative)
+	{
+		NegateWords(num.digits.data(), num.digits.size());
+
+		//a magnitude of exactly 2^(64n - 1) doesn't need the extra sign word once it's negative
+		RemoveRedundantWords(num.digits);
+	}
+	return num;
+}
+
+//ARITHMETIC OPERATORS
+//Addition Operators
+void int_64x_sm::addSigned(const int_64x_sm& num, bool num_negative)
+{
+	//Adds the magnitude of num to *this as if num had the sign "num_negative", this lets subtraction use the same code without
+	//having to create a negated copy of num. If the signs are the same then the magnitudes get added together and the sign stays
+	//the same. If the signs are different then the smaller magnitude is subtracted from the larger one and the answer takes the
+	//sign of the larger one.
+	if (this->negative == num_negative)
+	{
+		int size = num.magnitude.size();
+		if (this->magnitude.size() < size) this->magnitude.resize(size, 0);
+
+		unsigned long long carry = AddWords(this->magnitude.data(), num.magnitude.data(), size);
+		for (int i = size; carry && i < this->magnitude.size(); i++) carry = (++this->magnitude[i] == 0);
+		if (carry) this->magnitude.push_back(1);
+		return;
+	}
+
+	int comparison = CompareMagnitudes(*this, num);
+	if (comparison >= 0)
+	{
+		SubtractWordAt(this->magnitude.data(), this->magnitude.size(), num.magnitude.size(),
+			SubtractWords(this->magnitude.data(), num.magnitude.data(), num.magnitude.size()));
+		if (comparison == 0) this->negative = false;
+	}
+	else
+	{
+		//num has the larger magnitude so *this gets replaced by num - *this, which is done in place one word at a time
+		this->magnitude.resize(num.magnitude.size(), 0);
+
+		unsigned long long borrow = 0, difference;
+		for (int i = 0; i < num.magnitude.size(); i++)
+		{
+			difference = num.magnitude[i] - this->magnitude[i];
+			unsigned long long next_borrow = (difference > num.magnitude[i]) + (difference < borrow);
+			this->magnitude[i] = difference - borrow;
+			borrow = next_borrow;
+		}
+		this->negative = num_negative;
+	}
+
+	removeLeadingZeros();
+}
+int_64x_sm& int_64x_sm::operator+=(const int_64x_sm& num)
+{
+	addSigned(num, num.negative);
+	return *this;
+}
+int_64x_sm operator+(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	int_64x_sm num1_copy = num1;
+	num1_copy += num2;
+	return num1_copy;
+}
+
+//Subtraction Operators
+int_64x_sm& int_64x_sm::operator-=(const int_64x_sm& num)
+{
+	//subtraction is just addition with the sign of num flipped. A magnitude of 0 is the same with either sign.
+	addSigned(num, !num.negative && !num.isZero());
+	return *this;
+}
+int_64x_sm operator-(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	int_64x_sm num1_copy = num1;
+	num1_copy -= num2;
+	return num1_copy;
+}
+int_64x_sm int_64x_sm::operator-() const
+{
+	int_64x_sm num_copy = *this;
+	num_copy.negate();
+	return num_copy;
+}
+void int_64x_sm::negate()
+{
+	//0 is never negative
+	if (!isZero()) this->negative = !this->negative;
+}
+
+//Multiplication Operators
+int_64x_sm& int_64x_sm::operator*=(const int_64x_sm& num)
+{
+	//Since both magnitudes are already positive they can be multiplied directly. The answer needs its own array as every row of
+	//the product reads all of *this.
+	int this_size = this->magnitude.size(), num_size = num.magnitude.size();
+	std::vector<unsigned long long> product(this_size + num_size);
+	MultiplyMagnitudes(product.data(), this->magnitude.data(), this_size, num.magnitude.data(), num_size);
+
+	this->magnitude.swap(product);
+	this->negative ^= num.negative;
+	removeLeadingZeros();
+	return *this;
+}
+int_64x_sm operator*(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	int_64x_sm num1_copy = num1;
+	num1_copy *= num2;
+	return num1_copy;
+}
+
+//Division Operators
+void int_64x_sm::divide(const int_64x_sm& num, int_64x_sm* quotient, int_64x_sm* remainder) const
+{
+	//Divides the magnitudes with the word by word long division from int_64x.cpp. The quotient is negative if the signs are
+	//different while the remainder always takes the sign of *this, which matches the int_64x operators. Either of the outputs can
+	//be left as nullptr if it isn't needed. num can't be 0, if it is then both outputs are just set to *this.
+	if (num.isZero())
+	{
+		if (quotient) *quotient = *this;
+		if (remainder) *remainder = *this;
+		return;
+	}
+
+	if (CompareMagnitudes(*this, num) < 0)
+	{
+		if (quotient) *quotient = int_64x_sm();
+		if (remainder) *remainder = *this;
+		return;
+	}
+
+	int this_size = this->magnitude.size(), num_size = num.magnitude.size();
+	std::vector<unsigned long long> quotient_words(this_size - num_size + 1), remainder_words(num_size), scratch(this_size + num_size + 1);
+	DivideWords(quotient_words.data(), remainder_words.data(), this->magnitude.data(), this_size, num.magnitude.data(), num_size, scratch.data());
+
+	bool this_negative = this->negative;
+	if (quotient)
+	{
+		quotient->magnitude.swap(quotient_words);
+		quotient->negative = this_negative ^ num.negative;
+		quotient->removeLeadingZeros();
+	}
+	if (remainder)
+	{
+		remainder->magnitude.swap(remainder_words);
+		remainder->negative = this_negative;
+		remainder->removeLeadingZeros();
+	}
+}
+int_64x_sm& int_64x_sm::operator/=(const int_64x_sm& num)
+{
+	int_64x_sm quotient;
+	divide(num, &quotient, nullptr);
+	return (*this = quotient);
+}
+int_64x_sm operator/(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	int_64x_sm quotient;
+	num1.divide(num2, &quotient, nullptr);
+	return quotient;
+}
+int_64x_sm& int_64x_sm::operator%=(const int_64x_sm& num)
+{
+	//unlike the int_64x version there's no need to multiply the quotient back out, the division gives us the remainder directly
+	int_64x_sm remainder;
+	divide(num, nullptr, &remainder);
+	return (*this = remainder);
+}
+int_64x_sm operator%(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	int_64x_sm remainder;
+	num1.divide(num2, nullptr, &remainder);
+	return remainder;
+}
+
+//BINARY OPERATORS
+//Left Shift Operators
+int_64x_sm& int_64x_sm::operator<<=(const unsigned int left_shift)
+{
+	//shifting the magnitude is the same for positive and negative numbers, first shift by whole words and then shift the bits
+	if (!left_shift || isZero()) return *this;
+
+	int new_words = left_shift / 64, shift_amount = left_shift % 64;
+	if (shift_amount)
+	{
+		unsigned long long overflow = this->magnitude.back() >> (64 - shift_amount);
+		for (int i = this->magnitude.size() - 1; i > 0; i--)
+			this->magnitude[i] = (this->magnitude[i] << shift_amount) | (this->magnitude[i - 1] >> (64 - shift_amount));
+		this->magnitude[0] <<= shift_amount;
+		if (overflow) this->magnitude.push_back(overflow);
+	}
+	if (new_words) this->magnitude.insert(this->magnitude.begin(), new_words, 0);
+
+	return *this;
+}
+int_64x_sm operator<<(const int_64x_sm& num, const unsigned int left_shift)
+{
+	int_64x_sm num_copy = num;
+	num_copy <<= left_shift;
+	return num_copy;
+}
+
+//Right Shift Operators
+int_64x_sm& int_64x_sm::operator>>=(const unsigned int right_shift)
+{
+	//Right shifting a two's complement number rounds towards negative infinity, so to match the int_64x operator a negative number
+	//needs 1 added to its magnitude if any of the bits that get shifted out were 1's
+	if (!right_shift || isZero()) return *this;
+
+	int lost_words = right_shift / 64, shift_amount = right_shift % 64;
+	bool lost_bits = false;
+	for (int i = 0; i < lost_words && i < this->magnitude.size(); i++) lost_bits |= (this->magnitude[i] != 0);
+
+	if (lost_words >= this->magnitude.size())
+	{
+		*this = this->negative ? int_64x_sm(-1) : int_64x_sm();
+		return *this;
+	}
+
+	this->magnitude.erase(this->magnitude.begin(), this->magnitude.begin() + lost_words);
+	if (shift_amount)
+	{
+		lost_bits |= (this->magnitude[0] << (64 - shift_amount)) != 0;
+		for (int i = 0; i < this->magnitude.size() - 1; i++)
+			this->magnitude[i] = (this->magnitude[i] >> shift_amount) | (this->magnitude[i + 1] << (64 - shift_amount));
+		this->magnitude.back() >>= shift_amount;
+	}
+
+	if (this->negative && lost_bits)
+	{
+		this->magnitude.push_back(0);
+		AddWordAt(this->magnitude.data(), this->magnitude.size(), 0, 1);
+	}
+	removeLeadingZeros();
+	return *this;
+}
+int_64x_sm operator>>(const int_64x_sm& num, const unsigned int right_shift)
+{
+	int_64x_sm num_copy = num;
+	num_copy >>= right_shift;
+	return num_copy;
+}
+
+//OR and AND Operators
+int_64x_sm BitwiseMagnitudes(const int_64x_sm& num1, const int_64x_sm& num2, bool use_and)
+{
+	//The bitwise operators are defined on the two's complement form. Both numbers get written out that way with one more word than
+	//the longest magnitude (so the sign bit always has room), sign extended, and combined a word at a time. A negative answer is
+	//flipped back to a magnitude at the end, which can't overflow since its lead word is nothing but sign bits.
+	int size = ((num1.magnitude.size() > num2.magnitude.size()) ? num1.magnitude.size() : num2.magnitude.size()) + 1;
+	std::vector<unsigned long long> words1(size, 0), words2(size, 0);
+	for (int i = 0; i < num1.magnitude.size(); i++) words1[i] = num1.magnitude[i];
+	for (int i = 0; i < num2.magnitude.size(); i++) words2[i] = num2.magnitude[i];
+	if (num1.negative) NegateWords(words1.data(), size);
+	if (num2.negative) NegateWords(words2.data(), size);
+
+	for (int i = 0; i < size; i++) words1[i] = use_and ? (words1[i] & words2[i]) : (words1[i] | words2[i]);
+
+	int_64x_sm answer;
+	answer.negative = words1.back() >> 63;
+	if (answer.negative) NegateWords(words1.data(), size);
+	while (size > 1 && words1[size - 1] == 0) size--;
+	answer.magnitude.assign(words1.begin(), words1.begin() + size);
+	return answer;
+}
+int_64x_sm operator|(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	return BitwiseMagnitudes(num1, num2, false);
+}
+int_64x_sm operator&(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	return BitwiseMagnitudes(num1, num2, true);
+}
+
+//COMPARISON OPERATORS
+bool operator==(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	return (num1.negative == num2.negative) && (num1.magnitude == num2.magnitude);
+}
+bool operator!=(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	return !operator==(num1, num2);
+}
+bool operator<(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	//a negative number is always less than a positive one, otherwise compare the magnitudes. For two negative numbers the
+	//one with the larger magnitude is the smaller number
+	if (num1.negative != num2.negative) return num1.negative;
+
+	int comparison = CompareMagnitudes(num1, num2);
+	return num1.negative ? (comparison > 0) : (comparison < 0);
+}
+bool operator>(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	return operator<(num2, num1);
+}
+bool operator<=(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	return !operator>(num1, num2);
+}
+bool operator>=(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	return !operator<(num1, num2);
+}
+
+//OTHER FUNCTIONS
+std::string int_64x_sm::getNumberString() const
+{
+	//Since the magnitude is unsigned we can repeatedly divide it by 10^19 (the largest power of 10 that fits in a word) and each
+	//remainder gives us the next 19 decimal digits, starting from the least significant ones.
+	const unsigned long long ten_nineteen = 10000000000000000000ULL;
+	if (isZero()) return "0";
+
+	std::vector<unsigned long long> words = this->magnitude;
+	std::vector<unsigned long long> chunks;
+	int size = words.size();
+	while (size)
+	{
+		chunks.push_back(DivideWordsBySingle(words.data(), words.data(), size, ten_nineteen));
+		while (size && words[size - 1] == 0) size--;
+	}
+
+	std::string decimal = this->negative ? "-" : "";
+	decimal += std::to_string(chunks.back());
+	for (int i = chunks.size() - 2; i >= 0; i--)
+	{
+		std::string chunk = std::to_string(chunks[i]);
+		decimal += std::string(19 - chunk.length(), '0') + chunk;
+	}
+	return decimal;
+}
+bool int_64x_sm::isZero() const
+{
+	return this->magnitude.size() == 1 && this->magnitude[0] == 0;
+}
+void int_64x_sm::removeLeadingZeros()
+{
+	//keeps the magnitude at its shortest length, a magnitude of 0 is always positive
+	while (this->magnitude.size() > 1 && this->magnitude.back() == 0) this->magnitude.pop_back();
+	if (isZero()) this->negative = false;
+}
+
+//HELPER FUNCTIONS
+int CompareMagnitudes(const int_64x_sm& num1, const int_64x_sm& num2)
+{
+	//returns -1, 0 or 1 depending on whether |num1| is smaller than, equal to or larger than |num2|
+	if (num1.magnitude.size() != num2.magnitude.size()) return (num1.magnitude.size() < num2.magnitude.size()) ? -1 : 1;
+	return CompareWords(num1.magnitude.data(), num2.magnitude.data(), num1.magnitude.size());
+}
+
+//Printing Functions
+std::ostream& operator<<(std::ostream& os, const int_64x_sm& num)
+{
+	return os << num.getNumberString();
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+
+//The int_64x_sm class is a sign-magnitude sibling of the int_64x class. The int_64x type keeps its digits in two's complement form
+//which is great for the bitwise operators, but it means that multiplication, division and printing all have to flip negative
+//numbers to positive (a full pass with a carry) and then flip the answer back at the end. Positive numbers whose lead bit is a 1
+//also need an extra word of 0's in front of them just to hold the sign. Here the sign is kept separately from the magnitude, so
+//negation just flips a bool and the magnitude can be handed straight to the unsigned word kernels in int_64x.cpp.
+//
+//Converting between the two types is a single pass over the words. The arithmetic operators match int_64x (division rounds towards 0,
+//the remainder has the same sign as the dividend, and right shifting a negative number rounds towards negative infinity). The bitwise
+//operators work on the two's complement form of each number a word at a time, with the shorter number sign extended. Dividing by 0
+//isn't allowed, it just leaves the dividend as it is.
+
+class int_64x_sm
+{
+public:
+	//VARIABLES
+
+	//The magnitude of the number in the same word order as int_64x.digits. There's no sign bit and the lead word is never 0
+	//unless the number itself is 0, in which case magnitude holds a single 0 word and negative is false.
+	std::vector<unsigned long long> magnitude;
+	bool negative;
+
+	//CONSTRUCTORS
+	int_64x_sm(); //initializes to 0
+	int_64x_sm(int number);
+	int_64x_sm(unsigned int number);
+	int_64x_sm(long long number);
+	int_64x_sm(unsigned long long number);
+	int_64x_sm(std::string number);
+	int_64x_sm(const int_64x& num); //converts from two's complement
+
+	//CONVERSION
+	int_64x to_int_64x() const;
+
+	//ARITHMETIC OPERATORS
+	int_64x_sm& operator+=(const int_64x_sm& num);
+	friend int_64x_sm operator+(const int_64x_sm& num1, const int_64x_sm& num2);
+	int_64x_sm& operator-=(const int_64x_sm& num);
+	friend int_64x_sm operator-(const int_64x_sm& num1, const int_64x_sm& num2);
+	int_64x_sm& operator*=(const int_64x_sm& num);
+	friend int_64x_sm operator*(const int_64x_sm& num1, const int_64x_sm& num2);
+	int_64x_sm& operator/=(const int_64x_sm& num);
+	friend int_64x_sm operator/(const int_64x_sm& num1, const int_64x_sm& num2);
+	int_64x_sm& operator%=(const int_64x_sm& num);
+	friend int_64x_sm operator%(const int_64x_sm& num1, const int_64x_sm& num2);
+	int_64x_sm operator-() const;
+	void negate(); //O(1)
+
+	//BINARY OPERATORS
+	int_64x_sm& operator<<=(const unsigned int left_shift);
+	friend int_64x_sm operator<<(const int_64x_sm& num, const unsigned int left_shift);
+	int_64x_sm& operator>>=(const unsigned int right_shift);
+	friend int_64x_sm operator>>(const int_64x_sm& num, const unsigned int right_shift);
+	friend int_64x_sm operator|(const int_64x_sm& num1, const int_64x_sm& num2);
+	friend int_64x_sm operator&(const int_64x_sm& num1, const int_64x_sm& num2);
+
+	//BOOLEAN OPERATORS
+	friend bool operator==(const int_64x_sm& num1, const int_64x_sm& num2);
+	friend bool operator!=(const int_64x_sm& num1, const int_64x_sm& num2);
+	friend bool operator<(const int_64x_sm& num1, const int_64x_sm& num2);
+	friend bool operator>(const int_64x_sm& num1, const int_64x_sm& num2);
+	friend bool operator<=(const int_64x_sm& num1, const int_64x_sm& num2);
+	friend bool operator>=(const int_64x_sm& num1, const int_64x_sm& num2);
+
+	//OTHER FUNCTIONS
+	std::string getNumberString() const;
+	bool isZero() const;
+
+private:
+	void removeLeadingZeros();
+	void addSigned(const int_64x_sm& num, bool num_negative);
+	void divide(const int_64x_sm& num, int_64x_sm* quotient, int_64x_sm* remainder) const;
+};
+
+//Related Functions
+int CompareMagnitudes(const int_64x_sm& num1, const int_64x_sm& num2);
+int_64x_sm BitwiseMagnitudes(const int_64x_sm& num1, const int_64x_sm& num2, bool use_and); //the two's complement & (or | when use_and is false)
+
+//Printing Functions
+std::ostream& operator<<(std::ostream& os, const int_64x_sm& num);
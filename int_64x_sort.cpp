@@ -0,0 +1,184 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_sort.h>
+#include <Header_Files/int_64x_parallel.h>
+#include <algorithm>
+#include <cstring>
+
+//RADIX SORT HELPERS
+//Every key is "stride" words long with the most significant word first, so comparing two keys is just comparing their words in order
+int CompareKeys(const unsigned long long* key1, const unsigned long long* key2, int stride)
+{
+	for (int i = 0; i < stride; i++)
+	{
+		if (key1[i] != key2[i]) return (key1[i] < key2[i]) ? -1 : 1;
+	}
+	return 0;
+}
+void InsertionSortKeys(unsigned long long* keys, unsigned long long* spare, int count, int stride)
+{
+	//spare needs room for a single key
+	for (int i = 1; i < count; i++)
+	{
+		unsigned long long* key = keys + (size_t)i * stride;
+		int j = i;
+		while (j > 0 && CompareKeys(keys + (size_t)(j - 1) * stride, key, stride) > 0) j--;
+		if (j == i) continue;
+
+		std::memcpy(spare, key, stride * sizeof(unsigned long long));
+		std::memmove(keys + (size_t)(j + 1) * stride, keys + (size_t)j * stride, (size_t)(i - j) * stride * sizeof(unsigned long long));
+		std::memcpy(keys + (size_t)j * stride, spare, stride * sizeof(unsigned long long));
+	}
+}
+
+bool RadixPass(unsigned long long* keys, unsigned long long* temp, int count, int stride, int& digit, int* starts)
+{
+	//Moves on to the first byte (starting at "digit") that isn't the same for every key and splits the keys into 256 buckets with a
+	//counting sort on that byte. starts[b] is where bucket b begins, starts[256] = count. digit is left on the byte that was used.
+	if (count <= 1) return false;
+
+	for (; digit < 8 * stride; digit++)
+	{
+		int word = digit / 8, shift = 56 - 8 * (digit % 8);
+		for (int i = 0; i <= 256; i++) starts[i] = 0;
+		for (int i = 0; i < count; i++) starts[((keys[(size_t)i * stride + word] >> shift) & 0xFF) + 1]++;
+
+		bool split = true;
+		for (int i = 1; i <= 256; i++) if (starts[i] == count) split = false;
+		if (!split) continue;
+
+		for (int i = 1; i <= 256; i++) starts[i] += starts[i - 1];
+
+		int next[256];
+		for (int i = 0; i < 256; i++) next[i] = starts[i];
+		for (int i = 0; i < count; i++)
+		{
+			int bucket = (keys[(size_t)i * stride + word] >> shift) & 0xFF;
+			std::memcpy(temp + (size_t)next[bucket]++ * stride, keys + (size_t)i * stride, stride * sizeof(unsigned long long));
+		}
+		std::memcpy(keys, temp, (size_t)count * stride * sizeof(unsigned long long));
+		return true;
+	}
+	return false;
+}
+
+void RadixSortKeys(unsigned long long* keys, unsigned long long* temp, int count, int stride, int digit)
+{
+	//temp needs as much room as keys, each bucket only ever uses the part of temp that lines up with its own keys
+	if (count <= SORT_INSERTION_SIZE)
+	{
+		InsertionSortKeys(keys, temp, count, stride);
+		return;
+	}
+
+	int starts[257];
+	if (!RadixPass(keys, temp, count, stride, digit, starts)) return;
+	for (int i = 0; i < 256; i++)
+	{
+		size_t offset = (size_t)starts[i] * stride;
+		RadixSortKeys(keys + offset, temp + offset, starts[i + 1] - starts[i], stride, digit + 1);
+	}
+}
+
+//SORTING
+void sort_int_64x(int_64x* nums, int count, int threads)
+{
+	//The bins are kept in a sorted list of (sign, length) pairs instead of a table with a spot for every possible length since most
+	//arrays only have a few different lengths in them. lengths[i] is the length of number i, negative for negative numbers.
+	struct Bin
+	{
+		bool negative;
+		int length, count;
+		size_t offset; //where the keys of the bin start in the key buffer
+	};
+	std::vector<int> lengths(count);
+	std::vector<Bin> bins;
+	auto bin_order = [](const Bin& a, const Bin& b)
+	{
+		if (a.negative != b.negative) return a.negative;
+		return a.negative ? (a.length > b.length) : (a.length < b.length);
+	};
+
+	for (int i = 0; i < count; i++)
+	{
+		const int_64x_digits& digits = nums[i].digits;
+		Bin bin = { !digits.empty() && (digits.back() >> 63), digits.empty() ? 1 : SignificantWords(digits), 0, 0 };
+		lengths[i] = bin.negative ? -bin.length : bin.length;
+
+		auto spot = std::lower_bound(bins.begin(), bins.end(), bin, bin_order);
+		if (spot == bins.end() || spot->negative != bin.negative || spot->length != bin.length) spot = bins.insert(spot, bin);
+		spot->count++;
+	}
+
+	size_t total = 0;
+	for (int i = 0; i < bins.size(); i++)
+	{
+		bins[i].offset = total;
+		total += (size_t)bins[i].count * bins[i].length;
+	}
+
+	//copy the keys into the buffer, most significant word first
+	std::vector<unsigned long long> keys(total), temp(total);
+	std::vector<size_t> next(bins.size());
+	for (int i = 0; i < bins.size(); i++) next[i] = bins[i].offset;
+	for (int i = 0; i < count; i++)
+	{
+		Bin bin = { lengths[i] < 0, lengths[i] < 0 ? -lengths[i] : lengths[i], 0, 0 };
+		int b = std::lower_bound(bins.begin(), bins.end(), bin, bin_order) - bins.begin();
+		const int_64x_digits& digits = nums[i].digits;
+		for (int j = 0; j < bin.length; j++) keys[next[b]++] = digits.empty() ? 0 : digits[bin.length - 1 - j];
+	}
+
+	int_64x_thread_pool& pool = int_64x_thread_pool::shared();
+	if (threads != 1 && count >= SORT_PARALLEL_SIZE && pool.threads() > 1)
+	{
+		//each task is a run of keys from a single bin along with the digit its radix sort starts on
+		struct SortTask
+		{
+			size_t offset;
+			int count, stride, digit;
+		};
+		std::vector<SortTask> tasks;
+		for (int i = 0; i < bins.size(); i++)
+		{
+			SortTask whole = { bins[i].offset, bins[i].count, bins[i].length, 0 };
+			int starts[257], digit = 0;
+			if (bins[i].count < SORT_PARALLEL_SIZE / 16 || !RadixPass(keys.data() + whole.offset, temp.data() + whole.offset, whole.count, whole.stride, digit, starts))
+			{
+				tasks.push_back(whole);
+				continue;
+			}
+			for (int j = 0; j < 256; j++)
+			{
+				SortTask bucket = { whole.offset + (size_t)starts[j] * whole.stride, starts[j + 1] - starts[j], whole.stride, digit + 1 };
+				if (bucket.count > 1) tasks.push_back(bucket);
+			}
+		}
+
+		pool.run([&](int task)
+		{
+			const SortTask& sort = tasks[task];
+			RadixSortKeys(keys.data() + sort.offset, temp.data() + sort.offset, sort.count, sort.stride, sort.digit);
+		}, tasks.size(), threads);
+	}
+	else
+	{
+		for (int i = 0; i < bins.size(); i++) RadixSortKeys(keys.data() + bins[i].offset, temp.data() + bins[i].offset, bins[i].count, bins[i].length, 0);
+	}
+
+	//write the words back out in order
+	int position = 0;
+	for (int i = 0; i < bins.size(); i++)
+	{
+		const unsigned long long* key = keys.data() + bins[i].offset;
+		for (int j = 0; j < bins[i].count; j++, key += bins[i].length)
+		{
+			int_64x_digits& digits = nums[position++].digits;
+			digits.resize(bins[i].length);
+			for (int k = 0; k < bins[i].length; k++) digits[k] = key[bins[i].length - 1 - k];
+		}
+	}
+}
+void sort_int_64x(std::vector<int_64x>& nums, int threads)
+{
+	sort_int_64x(nums.data(), nums.size(), threads);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <vector>
+
+//SORTING
+//Sorting a large array of int_64x types with std::sort means every comparison checks the polarity and length of both numbers and
+//then walks their words through two separate heap pointers. sort_int_64x() never compares two numbers directly. Each number is put
+//into a bin based on its sign and its number of significant words: negative numbers come first with the longest ones at the front,
+//then positive numbers from shortest to longest. Inside of a bin all of the numbers have the same length and sign, so their two's
+//complement words sort the same way as unsigned numbers do. Each bin gets copied into a flat buffer of keys (the words of every number
+//from the most significant one down, one right after the other) and the keys are MSD radix sorted a byte at a time. Bytes where every
+//key in a bucket is the same are skipped without moving anything, and buckets small enough that radix passes aren't worth it get an
+//insertion sort. Once everything is sorted the words are written back into the original numbers straight out of the key buffer, so
+//each int_64x keeps its own memory (numbers with redundant lead words come back normalized).
+//
+//Arrays of at least SORT_PARALLEL_SIZE numbers are sorted on the shared int_64x_thread_pool: every bin that's big enough gets its
+//first radix pass on the calling thread, and then each of the buckets from those passes (along with every smaller bin) is sorted as a
+//separate task. threads = 0 uses every thread of the pool and threads = 1 keeps everything on the calling thread.
+const int SORT_INSERTION_SIZE = 32; //buckets with this many numbers or fewer are insertion sorted
+const int SORT_PARALLEL_SIZE = 1 << 16;
+
+void sort_int_64x(int_64x* nums, int count, int threads = 0);
+void sort_int_64x(std::vector<int_64x>& nums, int threads = 0);
+
+//Related Functions
+void RadixSortKeys(unsigned long long* keys, unsigned long long* temp, int count, int stride, int digit); //digit counts bytes from the top of the first word
+bool RadixPass(unsigned long long* keys, unsigned long long* temp, int count, int stride, int& digit, int* starts); //false if the keys are already sorted
+int CompareKeys(const unsigned long long* key1, const unsigned long long* key2, int stride);
+void InsertionSortKeys(unsigned long long* keys, unsigned long long* spare, int count, int stride);
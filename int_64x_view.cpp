@@ -0,0 +1,479 @@
+#include <Header_Files/pch.h>
+#include <Header_Files/int_64x_view.h>
+#include <Header_Files/int_64x_parallel.h>
+#include <cstring>
+#include <utility>
+
+//CONSTRUCTORS
+int_64x_view::int_64x_view() : limbs(nullptr), size(0), negative(false), complement(false)
+{
+}
+int_64x_view::int_64x_view(const unsigned long long* limbs, int size, bool negative) : limbs(limbs), size(size), negative(negative), complement(false)
+{
+}
+int_64x_view::int_64x_view(const int_64x& num) : limbs(num.digits.data()), size(num.digits.size())
+{
+	//a positive number's digits are already its magnitude (the extra sign word is just a lead 0), only negative numbers need to be
+	//flipped when they get used
+	negative = !num.digits.empty() && (num.digits.back() >> 63);
+	complement = negative;
+}
+int_64x_view::int_64x_view(const int_64x_sm& num) : limbs(num.magnitude.data()), size(num.magnitude.size()), negative(num.negative), complement(false)
+{
+}
+int_64x_view::int_64x_view(const int_64x_record& record) : limbs(record.limbs), size(record.size), negative(record.negative), complement(false)
+{
+}
+
+//CONVERSION
+int_64x int_64x_view::to_int_64x() const
+{
+	int_64x num;
+	StoreView(num, *this);
+	return num;
+}
+int_64x_sm int_64x_view::to_int_64x_sm() const
+{
+	int magnitude_size;
+	const unsigned long long* magnitude = LoadMagnitude(*this, int_64x_workspace::local(), int_64x_workspace::OPERAND_ONE, magnitude_size);
+
+	int_64x_sm num;
+	if (!magnitude_size) return num;
+	num.magnitude.assign(magnitude, magnitude + magnitude_size);
+	num.negative = this->negative;
+	return num;
+}
+
+//OTHER FUNCTIONS
+bool int_64x_view::isZero() const
+{
+	//the two's complement words of a negative number are never all 0, so only the words need to be checked
+	for (int i = 0; i < size; i++) if (limbs[i]) return false;
+	return true;
+}
+
+//SPANS
+int_64x_span::int_64x_span(unsigned long long* limbs, int capacity) : limbs(limbs), size(0), capacity(capacity), negative(false)
+{
+}
+int_64x_span::int_64x_span(unsigned long long* limbs, int size, int capacity, bool negative) : limbs(limbs), size(size), capacity(capacity), negative(negative)
+{
+	while (this->size && limbs[this->size - 1] == 0) this->size--;
+	if (!this->size) this->negative = false;
+}
+int_64x_span::operator int_64x_view() const
+{
+	return int_64x_view(limbs, size, negative);
+}
+int_64x int_64x_span::to_int_64x() const
+{
+	return int_64x_view(*this).to_int_64x();
+}
+bool int_64x_span::assign(const int_64x_view& num)
+{
+	//The magnitude is found first (which is a no-op for anything that isn't a negative int_64x) so that the capacity can be checked
+	//before anything gets overwritten. memmove is used since num could be looking at part of this span.
+	int magnitude_size;
+	const unsigned long long* magnitude = LoadMagnitude(num, int_64x_workspace::local(), int_64x_workspace::OPERAND_ONE, magnitude_size);
+	if (magnitude_size > capacity) return false;
+
+	if (magnitude_size && magnitude != limbs) std::memmove(limbs, magnitude, magnitude_size * sizeof(unsigned long long));
+	size = magnitude_size;
+	negative = num.negative && magnitude_size;
+	return true;
+}
+void int_64x_span::zero()
+{
+	size = 0;
+	negative = false;
+}
+
+//VIEW KERNELS
+//Loading Functions
+const unsigned long long* LoadMagnitude(const int_64x_view& num, int_64x_workspace& workspace, int buffer, int& size)
+{
+	//Returns the magnitude of num with any lead words of 0 trimmed off (so size is 0 for the number 0). Everything except for the
+	//two's complement words of a negative int_64x is already a magnitude and gets used right where it is, the others are flipped
+	//into the given buffer of the workspace.
+	const unsigned long long* magnitude = num.limbs;
+	size = num.size;
+	if (num.complement && size)
+	{
+		unsigned long long* words = workspace.buffer(buffer, size);
+		for (int i = 0; i < size; i++) words[i] = num.limbs[i];
+		NegateWords(words, size);
+		magnitude = words;
+	}
+
+	while (size && magnitude[size - 1] == 0) size--;
+	return magnitude;
+}
+void LoadComplement(const int_64x_view& num, unsigned long long* words, int size)
+{
+	//writes the two's complement form of num into words, sign extended out to "size" words. size needs to be at least one more than
+	//num.size so there's always room for the sign bit.
+	for (int i = 0; i < num.size; i++) words[i] = num.limbs[i];
+	for (int i = num.size; i < size; i++) words[i] = 0;
+
+	if (num.complement) for (int i = num.size; i < size; i++) words[i] = 0xFFFFFFFFFFFFFFFF;
+	else if (num.negative) NegateWords(words, size);
+}
+int_64x_view ResultView(const unsigned long long* words, int size, bool negative)
+{
+	//trims the lead words of 0 off of an answer, 0 is never negative
+	while (size && words[size - 1] == 0) size--;
+	return int_64x_view(words, size, negative && size);
+}
+void StoreView(int_64x& num, const int_64x_view& view)
+{
+	//The two's complement words of a negative int_64x can be copied straight over, everything else is a magnitude. Neither of the
+	//store functions allocates if num has held a number this big before.
+	if (view.complement) StoreWords(num.digits, view.limbs, view.size);
+	else
+	{
+		int size = view.size;
+		while (size && view.limbs[size - 1] == 0) size--;
+		if (size) StoreMagnitude(num.digits, view.limbs, size, view.negative);
+		else num.digits.assign(1, 0);
+	}
+}
+
+//Arithmetic Kernels
+int_64x_view AddViews(const int_64x_view& num1, const int_64x_view& num2, bool subtract, int_64x_workspace& workspace)
+{
+	//The same as int_64x_sm::addSigned(). The longer magnitude is copied into the answer first, then if the signs match the shorter one
+	//gets added to it, otherwise the smaller one gets subtracted from the larger one and the answer takes the sign of the larger one.
+	int size1, size2;
+	const unsigned long long* words1 = LoadMagnitude(num1, workspace, int_64x_workspace::OPERAND_ONE, size1);
+	const unsigned long long* words2 = LoadMagnitude(num2, workspace, int_64x_workspace::OPERAND_TWO, size2);
+	bool negative1 = num1.negative && size1, negative2 = (num2.negative != subtract) && size2;
+
+	if (size1 < size2 || (size1 == size2 && CompareWords(words1, words2, size1) < 0))
+	{
+		std::swap(words1, words2);
+		std::swap(size1, size2);
+		std::swap(negative1, negative2);
+	}
+
+	unsigned long long* answer = workspace.buffer(int_64x_workspace::RESULT, size1 + 1);
+	for (int i = 0; i < size1; i++) answer[i] = words1[i];
+	answer[size1] = 0;
+
+	if (negative1 == negative2) AddWordAt(answer, size1 + 1, size2, AddWords(answer, words2, size2));
+	else SubtractWordAt(answer, size1 + 1, size2, SubtractWords(answer, words2, size2));
+	return ResultView(answer, size1 + 1, negative1);
+}
+int_64x_view MultiplyViews(const int_64x_view& num1, const int_64x_view& num2, int_64x_workspace& workspace)
+{
+	//Both magnitudes can be handed straight to the same kernels that int_64x::multiply() uses, including the parallel ones when an
+	//int_64x_parallel_scope is active on this thread
+	int size1, size2;
+	const unsigned long long* words1 = LoadMagnitude(num1, workspace, int_64x_workspace::OPERAND_ONE, size1);
+	const unsigned long long* words2 = LoadMagnitude(num2, workspace, int_64x_workspace::OPERAND_TWO, size2);
+	if (!size1 || !size2) return int_64x_view();
+
+	unsigned long long* product = workspace.buffer(int_64x_workspace::RESULT, size1 + size2);
+	const int_64x_parallel_settings* parallel = int_64x_parallel_scope::active();
+	if (UseParallelMultiplication(size1, size2, parallel)) ParallelMultiplyMagnitudes(product, words1, size1, words2, size2, *parallel);
+	else if (num1.limbs == num2.limbs && num1.complement == num2.complement && size1 == size2) SquareWords(product, words1, size1);
+	else MultiplyMagnitudes(product, words1, size1, words2, size2);
+	return ResultView(product, size1 + size2, num1.negative != num2.negative);
+}
+bool DivideViews(const int_64x_view& num1, const int_64x_view& num2, int_64x_view& quotient, int_64x_view& remainder, int_64x_workspace& workspace)
+{
+	//Long division of the magnitudes with DivideWords(), laid out in the workspace the same way int_64x::divideMagnitudes() does it.
+	//The quotient is negative if the signs are different and the remainder keeps the sign of num1.
+	int size1, size2;
+	const unsigned long long* words1 = LoadMagnitude(num1, workspace, int_64x_workspace::OPERAND_ONE, size1);
+	const unsigned long long* words2 = LoadMagnitude(num2, workspace, int_64x_workspace::OPERAND_TWO, size2);
+	if (!size2) return false;
+
+	if (size1 < size2 || (size1 == size2 && CompareWords(words1, words2, size1) < 0))
+	{
+		//the remainder is just num1, it gets copied into the workspace anyway so that writing it out can't step on the quotient
+		unsigned long long* copy = workspace.buffer(int_64x_workspace::RESULT, size1);
+		for (int i = 0; i < size1; i++) copy[i] = words1[i];
+		quotient = int_64x_view();
+		remainder = ResultView(copy, size1, num1.negative);
+		return true;
+	}
+
+	unsigned long long* quotient_words = workspace.buffer(int_64x_workspace::RESULT, size1 - size2 + 1);
+	unsigned long long* scratch = workspace.buffer(int_64x_workspace::SCRATCH, size1 + 2 * size2 + 1);
+	unsigned long long* remainder_words = scratch + size1 + size2 + 1;
+	DivideWords(quotient_words, remainder_words, words1, size1, words2, size2, scratch);
+
+	quotient = ResultView(quotient_words, size1 - size2 + 1, num1.negative != num2.negative);
+	remainder = ResultView(remainder_words, size2, num1.negative);
+	return true;
+}
+
+//Binary Kernels
+int_64x_view ShiftViewLeft(const int_64x_view& num, const unsigned int left_shift, int_64x_workspace& workspace)
+{
+	//shifting the magnitude is the same for positive and negative numbers, the whole words become 0's and the rest of the bits get
+	//shifted as they're copied over
+	int size;
+	const unsigned long long* words = LoadMagnitude(num, workspace, int_64x_workspace::OPERAND_ONE, size);
+	if (!size) return int_64x_view();
+
+	int new_words = left_shift / 64, shift_amount = left_shift % 64;
+	unsigned long long* answer = workspace.buffer(int_64x_workspace::RESULT, size + new_words + 1);
+	for (int i = 0; i < new_words; i++) answer[i] = 0;
+
+	if (shift_amount)
+	{
+		answer[new_words + size] = words[size - 1] >> (64 - shift_amount);
+		for (int i = size - 1; i > 0; i--) answer[new_words + i] = (words[i] << shift_amount) | (words[i - 1] >> (64 - shift_amount));
+		answer[new_words] = words[0] << shift_amount;
+	}
+	else
+	{
+		answer[new_words + size] = 0;
+		for (int i = 0; i < size; i++) answer[new_words + i] = words[i];
+	}
+	return ResultView(answer, size + new_words + 1, num.negative);
+}
+int_64x_view ShiftViewRight(const int_64x_view& num, const unsigned int right_shift, int_64x_workspace& workspace)
+{
+	//Right shifting a two's complement number rounds towards negative infinity, so like int_64x_sm a negative number needs 1 added
+	//to its magnitude if any of the bits that get shifted out were 1's
+	int size;
+	const unsigned long long* words = LoadMagnitude(num, workspace, int_64x_workspace::OPERAND_ONE, size);
+	if (!size) return int_64x_view();
+
+	int lost_words = right_shift / 64, shift_amount = right_shift % 64;
+	bool negative = num.negative, lost_bits = false;
+	for (int i = 0; i < lost_words && i < size; i++) lost_bits |= (words[i] != 0);
+
+	int new_size = (lost_words < size) ? size - lost_words : 0;
+	unsigned long long* answer = workspace.buffer(int_64x_workspace::RESULT, new_size + 1);
+	if (new_size && shift_amount)
+	{
+		lost_bits |= (words[lost_words] << (64 - shift_amount)) != 0;
+		for (int i = 0; i < new_size - 1; i++) answer[i] = (words[lost_words + i] >> shift_amount) | (words[lost_words + i + 1] << (64 - shift_amount));
+		answer[new_size - 1] = words[size - 1] >> shift_amount;
+	}
+	else for (int i = 0; i < new_size; i++) answer[i] = words[lost_words + i];
+	answer[new_size] = 0;
+
+	if (negative && lost_bits) AddWordAt(answer, new_size + 1, 0, 1);
+	return ResultView(answer, new_size + 1, negative);
+}
+int_64x_view BitwiseViews(const int_64x_view& num1, const int_64x_view& num2, BitwiseOperation operation, int_64x_workspace& workspace)
+{
+	//The bitwise operators are defined on the two's complement form, so both numbers are written out that way (one word longer than
+	//the longest of them so the sign bit always has room) and combined a word at a time. A negative answer gets flipped back to a
+	//magnitude at the end, which can't overflow since its lead word is nothing but sign bits.
+	int size = ((num1.size > num2.size) ? num1.size : num2.size) + 1;
+	unsigned long long* answer = workspace.buffer(int_64x_workspace::RESULT, size);
+	unsigned long long* other = workspace.buffer(int_64x_workspace::SCRATCH, size);
+	LoadComplement(num1, answer, size);
+	LoadComplement(num2, other, size);
+
+	if (operation == BITWISE_AND) for (int i = 0; i < size; i++) answer[i] &= other[i];
+	else if (operation == BITWISE_OR) for (int i = 0; i < size; i++) answer[i] |= other[i];
+	else for (int i = 0; i < size; i++) answer[i] ^= other[i];
+
+	bool negative = answer[size - 1] >> 63;
+	if (negative) NegateWords(answer, size);
+	return ResultView(answer, size, negative);
+}
+int CompareViews(const int_64x_view& num1, const int_64x_view& num2, int_64x_workspace& workspace)
+{
+	int size1, size2;
+	const unsigned long long* words1 = LoadMagnitude(num1, workspace, int_64x_workspace::OPERAND_ONE, size1);
+	const unsigned long long* words2 = LoadMagnitude(num2, workspace, int_64x_workspace::OPERAND_TWO, size2);
+	bool negative1 = num1.negative && size1, negative2 = num2.negative && size2;
+	if (negative1 != negative2) return negative1 ? -1 : 1;
+
+	//the longer magnitude is bigger, two negative numbers go the other way
+	int comparison = (size1 != size2) ? ((size1 < size2) ? -1 : 1) : CompareWords(words1, words2, size1);
+	return negative1 ? -comparison : comparison;
+}
+
+//RELATED FUNCTIONS
+bool add(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	return result.assign(AddViews(num1, num2, false, int_64x_workspace::local()));
+}
+void add(int_64x& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	StoreView(result, AddViews(num1, num2, false, int_64x_workspace::local()));
+}
+bool subtract(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	return result.assign(AddViews(num1, num2, true, int_64x_workspace::local()));
+}
+void subtract(int_64x& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	StoreView(result, AddViews(num1, num2, true, int_64x_workspace::local()));
+}
+bool multiply(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	return result.assign(MultiplyViews(num1, num2, int_64x_workspace::local()));
+}
+void multiply(int_64x& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	StoreView(result, MultiplyViews(num1, num2, int_64x_workspace::local()));
+}
+bool divide(int_64x_span* quotient, int_64x_span* remainder, const int_64x_view& num1, const int_64x_view& num2)
+{
+	//both answers need to fit before either of them gets written so a failure never leaves half of the answer behind
+	int_64x_view quotient_view, remainder_view;
+	if (!DivideViews(num1, num2, quotient_view, remainder_view, int_64x_workspace::local())) return false;
+
+	bool quotient_fits = !quotient || quotient_view.size <= quotient->capacity;
+	bool remainder_fits = !remainder || remainder_view.size <= remainder->capacity;
+	if (!quotient_fits || !remainder_fits) return false;
+
+	if (quotient) quotient->assign(quotient_view);
+	if (remainder) remainder->assign(remainder_view);
+	return true;
+}
+bool divide(int_64x* quotient, int_64x* remainder, const int_64x_view& num1, const int_64x_view& num2)
+{
+	int_64x_view quotient_view, remainder_view;
+	if (!DivideViews(num1, num2, quotient_view, remainder_view, int_64x_workspace::local())) return false;
+
+	if (quotient) StoreView(*quotient, quotient_view);
+	if (remainder) StoreView(*remainder, remainder_view);
+	return true;
+}
+bool shift_left(int_64x_span& result, const int_64x_view& num, const unsigned int left_shift)
+{
+	return result.assign(ShiftViewLeft(num, left_shift, int_64x_workspace::local()));
+}
+void shift_left(int_64x& result, const int_64x_view& num, const unsigned int left_shift)
+{
+	StoreView(result, ShiftViewLeft(num, left_shift, int_64x_workspace::local()));
+}
+bool shift_right(int_64x_span& result, const int_64x_view& num, const unsigned int right_shift)
+{
+	return result.assign(ShiftViewRight(num, right_shift, int_64x_workspace::local()));
+}
+void shift_right(int_64x& result, const int_64x_view& num, const unsigned int right_shift)
+{
+	StoreView(result, ShiftViewRight(num, right_shift, int_64x_workspace::local()));
+}
+bool bit_and(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	return result.assign(BitwiseViews(num1, num2, BITWISE_AND, int_64x_workspace::local()));
+}
+void bit_and(int_64x& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	StoreView(result, BitwiseViews(num1, num2, BITWISE_AND, int_64x_workspace::local()));
+}
+bool bit_or(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	return result.assign(BitwiseViews(num1, num2, BITWISE_OR, int_64x_workspace::local()));
+}
+void bit_or(int_64x& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	StoreView(result, BitwiseViews(num1, num2, BITWISE_OR, int_64x_workspace::local()));
+}
+bool bit_xor(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	return result.assign(BitwiseViews(num1, num2, BITWISE_XOR, int_64x_workspace::local()));
+}
+void bit_xor(int_64x& result, const int_64x_view& num1, const int_64x_view& num2)
+{
+	StoreView(result, BitwiseViews(num1, num2, BITWISE_XOR, int_64x_workspace::local()));
+}
+int compare(const int_64x_view& num1, const int_64x_view& num2)
+{
+	return CompareViews(num1, num2, int_64x_workspace::local());
+}
+
+//OPERATORS
+int_64x operator+(const int_64x_view& num1, const int_64x_view& num2)
+{
+	int_64x answer;
+	add(answer, num1, num2);
+	return answer;
+}
+int_64x operator-(const int_64x_view& num1, const int_64x_view& num2)
+{
+	int_64x answer;
+	subtract(answer, num1, num2);
+	return answer;
+}
+int_64x operator*(const int_64x_view& num1, const int_64x_view& num2)
+{
+	int_64x answer;
+	multiply(answer, num1, num2);
+	return answer;
+}
+int_64x operator/(const int_64x_view& num1, const int_64x_view& num2)
+{
+	//like the int_64x operator, dividing by 0 leaves num1 as it is
+	int_64x answer;
+	if (!divide(&answer, nullptr, num1, num2)) return num1.to_int_64x();
+	return answer;
+}
+int_64x operator%(const int_64x_view& num1, const int_64x_view& num2)
+{
+	int_64x answer;
+	if (!divide(nullptr, &answer, num1, num2)) return num1.to_int_64x();
+	return answer;
+}
+int_64x operator<<(const int_64x_view& num, const unsigned int left_shift)
+{
+	int_64x answer;
+	shift_left(answer, num, left_shift);
+	return answer;
+}
+int_64x operator>>(const int_64x_view& num, const unsigned int right_shift)
+{
+	int_64x answer;
+	shift_right(answer, num, right_shift);
+	return answer;
+}
+int_64x operator&(const int_64x_view& num1, const int_64x_view& num2)
+{
+	int_64x answer;
+	bit_and(answer, num1, num2);
+	return answer;
+}
+int_64x operator|(const int_64x_view& num1, const int_64x_view& num2)
+{
+	int_64x answer;
+	bit_or(answer, num1, num2);
+	return answer;
+}
+int_64x operator^(const int_64x_view& num1, const int_64x_view& num2)
+{
+	int_64x answer;
+	bit_xor(answer, num1, num2);
+	return answer;
+}
+bool operator==(const int_64x_view& num1, const int_64x_view& num2)
+{
+	return compare(num1, num2) == 0;
+}
+bool operator!=(const int_64x_view& num1, const int_64x_view& num2)
+{
+	return compare(num1, num2) != 0;
+}
+bool operator<(const int_64x_view& num1, const int_64x_view& num2)
+{
+	return compare(num1, num2) < 0;
+}
+bool operator>(const int_64x_view& num1, const int_64x_view& num2)
+{
+	return compare(num1, num2) > 0;
+}
+bool operator<=(const int_64x_view& num1, const int_64x_view& num2)
+{
+	return compare(num1, num2) <= 0;
+}
+bool operator>=(const int_64x_view& num1, const int_64x_view& num2)
+{
+	return compare(num1, num2) >= 0;
+}
+
+//PRINTING FUNCTIONS
+std::ostream& operator<<(std::ostream& os, const int_64x_view& num)
+{
+	return os << num.to_int_64x();
+}
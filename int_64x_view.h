@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Header_Files/int_64x.h>
+#include <Header_Files/int_64x_sm.h>
+#include <Header_Files/int_64x_serialize.h>
+#include <ostream>
+
+//VIEWS
+//Every int_64x owns its words, so working with numbers that already live somewhere else (a record in a mapped file, a buffer handed
+//over by another library, a slice of some bigger array) means copying them into an int_64x first and copying the answer back out
+//afterwards. An int_64x_view is just a pointer, a length and a sign that look at words owned by somebody else, and the functions below
+//take views for their operands directly so nothing gets copied on the way in. A view uses the same sign-magnitude form as int_64x_sm
+//and int_64x_record (the limbs are the magnitude, least significant word first, and lead words of 0 are fine), so views of either of
+//those are free to create.
+//
+//An int_64x keeps negative numbers in two's complement, so a view of one points straight at its digits and sets "complement" to let
+//the functions know that the words need to be flipped before they're used as a magnitude. Since the functions all borrow their
+//temporary memory from the thread's int_64x_workspace this flip doesn't allocate anything once the workspace has warmed up. Any view
+//is only good for as long as the memory it looks at stays put, so a view of a temporary (or of an int_64x that gets changed
+//afterwards) shouldn't be kept around.
+//
+//The answers match int_64x_sm exactly: division rounds towards 0 and the remainder has the sign of the dividend, right shifting a
+//negative number rounds towards negative infinity and the bitwise operators work on the two's complement form of each number.
+class int_64x_view
+{
+public:
+	//VARIABLES
+	const unsigned long long* limbs;
+	int size;
+	bool negative;
+	bool complement; //true when limbs holds the two's complement words of a negative number instead of its magnitude
+
+	//CONSTRUCTORS
+	int_64x_view(); //a view of 0
+	int_64x_view(const unsigned long long* limbs, int size, bool negative = false);
+	int_64x_view(const int_64x& num);
+	int_64x_view(const int_64x_sm& num);
+	int_64x_view(const int_64x_record& record);
+
+	//CONVERSION
+	int_64x to_int_64x() const;
+	int_64x_sm to_int_64x_sm() const;
+
+	//OTHER FUNCTIONS
+	bool isZero() const;
+};
+
+//An int_64x_span is the writable version of a view, it holds a magnitude in "capacity" words of memory that it doesn't own and can
+//be used as the destination of any of the functions below. The span never grows, if an answer needs more than capacity words then
+//false is returned and the span is left the way it was. A span can be passed anywhere a view is expected, and
+//the destination can be one of the operands since every answer is worked out in the workspace before it's copied over.
+class int_64x_span
+{
+public:
+	//VARIABLES
+	unsigned long long* limbs;
+	int size; //the number of significant words in limbs, 0 when the span holds 0
+	int capacity;
+	bool negative;
+
+	//CONSTRUCTORS
+	int_64x_span(unsigned long long* limbs, int capacity); //the span starts out holding 0
+	int_64x_span(unsigned long long* limbs, int size, int capacity, bool negative = false); //for a magnitude that's already in limbs
+
+	//CONVERSION
+	operator int_64x_view() const;
+	int_64x to_int_64x() const;
+
+	//OTHER FUNCTIONS
+	bool assign(const int_64x_view& num); //copies num into the span, false if it doesn't fit
+	void zero();
+};
+
+//Related Functions
+//Each operation has a span version, which returns false if the answer doesn't fit, and an int_64x version which reuses the memory
+//that result already holds. divide() can leave out either the quotient or the remainder by passing nullptr and returns false (without
+//touching either of them) when num2 is 0.
+bool add(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2);
+void add(int_64x& result, const int_64x_view& num1, const int_64x_view& num2);
+bool subtract(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2);
+void subtract(int_64x& result, const int_64x_view& num1, const int_64x_view& num2);
+bool multiply(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2);
+void multiply(int_64x& result, const int_64x_view& num1, const int_64x_view& num2);
+bool divide(int_64x_span* quotient, int_64x_span* remainder, const int_64x_view& num1, const int_64x_view& num2);
+bool divide(int_64x* quotient, int_64x* remainder, const int_64x_view& num1, const int_64x_view& num2);
+bool shift_left(int_64x_span& result, const int_64x_view& num, const unsigned int left_shift);
+void shift_left(int_64x& result, const int_64x_view& num, const unsigned int left_shift);
+bool shift_right(int_64x_span& result, const int_64x_view& num, const unsigned int right_shift);
+void shift_right(int_64x& result, const int_64x_view& num, const unsigned int right_shift);
+bool bit_and(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2);
+void bit_and(int_64x& result, const int_64x_view& num1, const int_64x_view& num2);
+bool bit_or(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2);
+void bit_or(int_64x& result, const int_64x_view& num1, const int_64x_view& num2);
+bool bit_xor(int_64x_span& result, const int_64x_view& num1, const int_64x_view& num2);
+void bit_xor(int_64x& result, const int_64x_view& num1, const int_64x_view& num2);
+int compare(const int_64x_view& num1, const int_64x_view& num2); //-1, 0 or 1
+
+//The operators return a new int_64x. An operator between two int_64x types still uses the int_64x version, these get picked as soon
+//as one side is a view, a span or a record.
+int_64x operator+(const int_64x_view& num1, const int_64x_view& num2);
+int_64x operator-(const int_64x_view& num1, const int_64x_view& num2);
+int_64x operator*(const int_64x_view& num1, const int_64x_view& num2);
+int_64x operator/(const int_64x_view& num1, const int_64x_view& num2);
+int_64x operator%(const int_64x_view& num1, const int_64x_view& num2);
+int_64x operator<<(const int_64x_view& num, const unsigned int left_shift);
+int_64x operator>>(const int_64x_view& num, const unsigned int right_shift);
+int_64x operator&(const int_64x_view& num1, const int_64x_view& num2);
+int_64x operator|(const int_64x_view& num1, const int_64x_view& num2);
+int_64x operator^(const int_64x_view& num1, const int_64x_view& num2);
+bool operator==(const int_64x_view& num1, const int_64x_view& num2);
+bool operator!=(const int_64x_view& num1, const int_64x_view& num2);
+bool operator<(const int_64x_view& num1, const int_64x_view& num2);
+bool operator>(const int_64x_view& num1, const int_64x_view& num2);
+bool operator<=(const int_64x_view& num1, const int_64x_view& num2);
+bool operator>=(const int_64x_view& num1, const int_64x_view& num2);
+
+//View Kernels
+//These do the actual work for everything above. The answer is left in the RESULT buffer of the workspace (the remainder of a division
+//goes in SCRATCH) and the view that's returned points at it, so it's only good until the workspace gets used again.
+enum BitwiseOperation { BITWISE_AND, BITWISE_OR, BITWISE_XOR };
+const unsigned long long* LoadMagnitude(const int_64x_view& num, int_64x_workspace& workspace, int buffer, int& size);
+void LoadComplement(const int_64x_view& num, unsigned long long* words, int size);
+int_64x_view AddViews(const int_64x_view& num1, const int_64x_view& num2, bool subtract, int_64x_workspace& workspace);
+int_64x_view MultiplyViews(const int_64x_view& num1, const int_64x_view& num2, int_64x_workspace& workspace);
+bool DivideViews(const int_64x_view& num1, const int_64x_view& num2, int_64x_view& quotient, int_64x_view& remainder, int_64x_workspace& workspace);
+int_64x_view ShiftViewLeft(const int_64x_view& num, const unsigned int left_shift, int_64x_workspace& workspace);
+int_64x_view ShiftViewRight(const int_64x_view& num, const unsigned int right_shift, int_64x_workspace& workspace);
+int_64x_view BitwiseViews(const int_64x_view& num1, const int_64x_view& num2, BitwiseOperation operation, int_64x_workspace& workspace);
+int CompareViews(const int_64x_view& num1, const int_64x_view& num2, int_64x_workspace& workspace);
+void StoreView(int_64x& num, const int_64x_view& view);
+
+//Printing Functions
+std::ostream& operator<<(std::ostream& os, const int_64x_view& num);